@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../include/StepGenerator.hpp"
+#include "../include/TuringMachine.hpp"
+
+/**
+ * @brief Benchmark de la ejecución por tramos
+ *
+ * Ejecuta kMachines copias de una máquina sintética que nunca se detiene, kSteps pasos cada
+ * una: primero una tras otra con run() y después intercaladas por turnos con StepGenerator,
+ * con tramos de k pasos. Mide el coste por paso de detener y reanudar las ejecuciones.
+ */
+
+namespace {
+
+const std::vector<char> kSymbols = {'.', 'a', 'b', 'c'};
+
+std::string stateName(size_t i) {
+  return "q" + std::to_string(i);
+}
+
+TuringMachine syntheticMachine(size_t num_states) {
+  std::set<std::string> states;
+  for (size_t i = 0; i < num_states; ++i) {
+    states.insert(stateName(i));
+  }
+  Alphabet gamma(std::set<char>(kSymbols.begin(), kSymbols.end()));
+  TuringMachine tm(states, Alphabet(std::set<char>{'a'}), gamma, stateName(0), '.', {}, 1);
+  for (size_t i = 0; i < num_states; ++i) {
+    for (size_t s = 0; s < kSymbols.size(); ++s) {
+      size_t next = (i * 7 + s * 13 + 1) % num_states;
+      char write = kSymbols[(i + s) % kSymbols.size()];
+      Movement move = ((i + s) % 2 == 0) ? Movement::RIGHT : Movement::LEFT;
+      tm.addTransition(Transition(stateName(i), {kSymbols[s]}, stateName(next), {write}, {move}));
+    }
+  }
+  tm.compile();
+  return tm;
+}
+
+double seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, size_t steps, double elapsed, size_t checksum) {
+  std::printf("%-14s %12zu pasos %10.3f ns/paso  (checksum %zu)\n", name, steps, elapsed * 1e9 / steps, checksum);
+}
+
+}  // namespace
+
+int main() {
+  const size_t kMachines = 256;
+  const size_t kSteps = 200000;
+  const std::string input(64, 'a');
+
+  TuringMachine prototype = syntheticMachine(64);
+  std::vector<TuringMachine> machines(kMachines, prototype);
+
+  size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (auto& tm : machines) {
+    tm.run(input, kSteps);
+    checksum += tm.getStepCount() + tm.getTapesContent()[0].size();
+  }
+  report("run", kMachines * kSteps, seconds(start), checksum);
+
+  for (size_t chunk : {16, 256, 4096, 65536}) {
+    std::vector<StepGenerator> generators;
+    for (auto& tm : machines) {
+      generators.emplace_back(tm, input, chunk, kSteps);
+    }
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (bool pending = true; pending;) {
+      pending = false;
+      for (auto& generator : generators) {
+        StepStatus status;
+        pending |= generator.next(status);
+      }
+    }
+    for (auto& tm : machines) {
+      checksum += tm.getStepCount() + tm.getTapesContent()[0].size();
+    }
+    std::string name = "tramos k=" + std::to_string(chunk);
+    report(name.c_str(), kMachines * kSteps, seconds(start), checksum);
+  }
+  return 0;
+}
@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/TransitionTable.hpp"
+#include "../include/TuringMachine.hpp"
+
+/**
+ * @brief Benchmark del despacho de transiciones: pasos/s frente a |δ|
+ *
+ * Genera máquinas sintéticas totales (nunca se detienen) de una cinta con |Γ| = 4 y
+ * un número creciente de estados, y mide:
+ *  - pasos/s de TuringMachine::run (tabla de despacho)
+ *  - búsquedas/s de la búsqueda lineal con Transition::matches (implementación anterior)
+ *  - búsquedas/s de TransitionTable::find
+ *
+ * Después compara, para k = 2 a 8 cintas, una δ escrita con comodines (una fila por estado que
+ * lee cualquier símbolo y conserva las cintas que no toca, más una fila exacta) con la misma δ
+ * expandida a las |Γ|^k combinaciones: filas, entradas de la tabla de despacho, tiempo de
+ * compilación de la máquina, búsquedas/s y pasos/s.
+ */
+
+namespace {
+
+const std::vector<char> kSymbols = {'.', 'a', 'b', 'c'};
+
+std::string stateName(size_t i) {
+  return "q" + std::to_string(i);
+}
+
+std::vector<Transition> syntheticTransitions(size_t num_states) {
+  std::vector<Transition> transitions;
+  for (size_t i = 0; i < num_states; ++i) {
+    for (size_t s = 0; s < kSymbols.size(); ++s) {
+      size_t next = (i * 7 + s * 13 + 1) % num_states;
+      char write = kSymbols[(i + s) % kSymbols.size()];
+      Movement move = ((i + s) % 2 == 0) ? Movement::RIGHT : Movement::LEFT;
+      transitions.emplace_back(stateName(i), std::vector<char>{kSymbols[s]}, stateName(next),
+                               std::vector<char>{write}, std::vector<Movement>{move});
+    }
+  }
+  return transitions;
+}
+
+double seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+const size_t kWildcardStates = 4;
+
+/**
+ * @brief δ de k cintas con comodines: el estado i escribe en la cinta i % k y avanza su cabezal
+ *
+ * Cada estado tiene además una fila exacta (todas las cintas en blanco) que va a otro estado.
+ */
+std::vector<Transition> wildcardTransitions(size_t num_tapes) {
+  std::vector<Transition> transitions;
+  for (size_t i = 0; i < kWildcardStates; ++i) {
+    std::vector<char> blanks(num_tapes, '.');
+    std::vector<Movement> moves(num_tapes, Movement::STAY);
+    moves[i % num_tapes] = Movement::RIGHT;
+    transitions.emplace_back(stateName(i), blanks, stateName((i + 2) % kWildcardStates), blanks, moves);
+
+    std::vector<char> read(num_tapes, Transition::kWildcard);
+    std::vector<char> write(num_tapes, Transition::kWildcard);
+    write[i % num_tapes] = kSymbols[1 + i % (kSymbols.size() - 1)];
+    transitions.emplace_back(stateName(i), read, stateName((i + 1) % kWildcardStates), write, moves);
+  }
+  return transitions;
+}
+
+/**
+ * @brief La misma δ con cada fila con comodines expandida a todas las combinaciones de Γ
+ */
+std::vector<Transition> expandedTransitions(size_t num_tapes) {
+  std::vector<Transition> transitions;
+  for (const Transition& transition : wildcardTransitions(num_tapes)) {
+    if (transition.getReadSymbols()[0] != Transition::kWildcard) {
+      transitions.push_back(transition);
+      continue;
+    }
+    std::vector<size_t> digits(num_tapes, 0);
+    for (bool more = true; more;) {
+      std::vector<char> read(num_tapes);
+      std::vector<char> write = transition.getWriteSymbols();
+      for (size_t t = 0; t < num_tapes; ++t) {
+        read[t] = kSymbols[digits[t]];
+        if (write[t] == Transition::kWildcard) {
+          write[t] = read[t];
+        }
+      }
+      transitions.emplace_back(transition.getCurrentState(), read, transition.getNextState(), write,
+                               transition.getMovements());
+      more = false;
+      for (size_t t = 0; t < num_tapes && !more; ++t) {
+        digits[t] = (digits[t] + 1) % kSymbols.size();
+        more = digits[t] != 0;
+      }
+    }
+  }
+  return transitions;
+}
+
+/**
+ * @brief Mide una δ de k cintas: filas, entradas, compilación, búsquedas/s y pasos/s
+ */
+void measureTapes(size_t num_tapes, const char* name, const std::vector<Transition>& transitions) {
+  const size_t kSteps = 2000000;
+  const size_t kLookups = 200000;
+
+  std::set<std::string> states;
+  for (size_t i = 0; i < kWildcardStates; ++i) {
+    states.insert(stateName(i));
+  }
+  Alphabet gamma(std::set<char>(kSymbols.begin(), kSymbols.end()));
+  TuringMachine tm(states, Alphabet(std::set<char>{'a'}), gamma, stateName(0), '.', {}, num_tapes);
+  for (const auto& transition : transitions) {
+    tm.addTransition(transition);
+  }
+  auto start = std::chrono::steady_clock::now();
+  tm.compile();
+  double compile_time = seconds(start);
+
+  size_t exact_keys = 0;
+  for (const auto& transition : transitions) {
+    const std::vector<char>& read = transition.getReadSymbols();
+    exact_keys += std::find(read.begin(), read.end(), Transition::kWildcard) == read.end();
+  }
+  TransitionTable table(kWildcardStates, gamma, num_tapes, nullptr, exact_keys);
+  for (size_t i = 0; i < transitions.size(); ++i) {
+    table.insert(tm.getProgram()->getStateIndex(transitions[i].getCurrentState()), transitions[i].getReadSymbols(),
+                 static_cast<int32_t>(i));
+  }
+
+  std::mt19937 rng(42);
+  std::vector<char> keys(kLookups * num_tapes);
+  for (char& symbol : keys) {
+    symbol = kSymbols[rng() % kSymbols.size()];
+  }
+  size_t found = 0;
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kLookups; ++i) {
+    found += table.find(i % kWildcardStates, &keys[i * num_tapes]) != TransitionTable::kNoTransition;
+  }
+  double lookup_rate = kLookups / seconds(start);
+
+  start = std::chrono::steady_clock::now();
+  tm.run("", kSteps);
+  double run_rate = tm.getStepCount() / seconds(start);
+
+  std::printf("%3zu %-10s %8zu %10zu %12.3f %14.3e %14.3e\n", num_tapes, name, transitions.size(),
+              table.getNumEntries(), compile_time * 1e3, lookup_rate, run_rate);
+  if (found != kLookups) {
+    std::fprintf(stderr, "Resultado inconsistente en las búsquedas\n");
+    std::exit(1);
+  }
+}
+
+}  // namespace
+
+int main() {
+  const size_t kSteps = 2000000;
+  const size_t kLookups = 200000;
+
+  std::printf("%10s %16s %18s %18s\n", "|δ|", "pasos/s (run)", "lineal (busq/s)", "tabla (busq/s)");
+
+  for (size_t num_states : {4, 16, 64, 256, 1024, 4096}) {
+    std::set<std::string> states;
+    for (size_t i = 0; i < num_states; ++i) {
+      states.insert(stateName(i));
+    }
+    Alphabet gamma(std::set<char>(kSymbols.begin(), kSymbols.end()));
+    TuringMachine tm(states, Alphabet(std::set<char>{'a'}), gamma, stateName(0), '.', {}, 1);
+    std::vector<Transition> transitions = syntheticTransitions(num_states);
+    for (const auto& transition : transitions) {
+      tm.addTransition(transition);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    tm.run("", kSteps);
+    double run_rate = tm.getStepCount() / seconds(start);
+
+    // Claves de búsqueda aleatorias (estado, símbolo)
+    std::mt19937 rng(42);
+    std::vector<std::pair<size_t, char>> keys;
+    for (size_t i = 0; i < kLookups; ++i) {
+      keys.emplace_back(rng() % num_states, kSymbols[rng() % kSymbols.size()]);
+    }
+
+    // Índices de estado según el orden de std::set, como en TuringMachine
+    std::vector<std::string> names(states.begin(), states.end());
+    std::map<std::string, size_t> index;
+    for (size_t i = 0; i < names.size(); ++i) {
+      index[names[i]] = i;
+    }
+
+    size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& key : keys) {
+      std::vector<char> symbols{key.second};
+      for (const auto& transition : transitions) {
+        if (transition.matches(names[key.first], symbols)) {
+          ++found;
+          break;
+        }
+      }
+    }
+    double linear_rate = kLookups / seconds(start);
+
+    TransitionTable table(num_states, gamma, 1);
+    for (size_t i = 0; i < transitions.size(); ++i) {
+      table.insert(index[transitions[i].getCurrentState()], transitions[i].getReadSymbols(),
+                   static_cast<int32_t>(i));
+    }
+    start = std::chrono::steady_clock::now();
+    for (const auto& key : keys) {
+      found += table.find(key.first, &key.second) != TransitionTable::kNoTransition;
+    }
+    double table_rate = kLookups / seconds(start);
+
+    std::printf("%10zu %16.3e %18.3e %18.3e\n", transitions.size(), run_rate, linear_rate, table_rate);
+    if (found != 2 * kLookups) {
+      std::fprintf(stderr, "Resultado inconsistente en las búsquedas\n");
+      return 1;
+    }
+  }
+
+  std::printf("\n%3s %-10s %8s %10s %12s %14s %14s\n", "k", "δ", "filas", "entradas", "compilar ms",
+              "busq/s", "pasos/s");
+  for (size_t num_tapes = 2; num_tapes <= 8; num_tapes += 2) {
+    measureTapes(num_tapes, "comodines", wildcardTransitions(num_tapes));
+    measureTapes(num_tapes, "expandida", expandedTransitions(num_tapes));
+  }
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "../include/TuringMachine.hpp"
+
+/**
+ * @brief Benchmark de la búsqueda no determinista
+ *
+ * La máquina elige en cada celda de la entrada a^n entre escribir x o y, y al llegar al final
+ * vuelve atrás y solo acepta si todas son y: la única rama aceptada es la última de las 2^n del
+ * último nivel. Mide configuraciones/s en anchura y en profundidad iterativa con 1, 2, 4 y 8 hilos.
+ */
+
+namespace {
+
+TuringMachine guessingMachine() {
+  std::set<std::string> states = {"g", "c", "f"};
+  Alphabet gamma(std::set<char>{'.', 'a', 'x', 'y'});
+  TuringMachine tm(states, Alphabet(std::set<char>{'a'}), gamma, "g", '.', {"f"}, 1);
+  tm.addTransition(Transition("g", {'a'}, "g", {'x'}, {Movement::RIGHT}));
+  tm.addTransition(Transition("g", {'a'}, "g", {'y'}, {Movement::RIGHT}));
+  tm.addTransition(Transition("g", {'.'}, "c", {'.'}, {Movement::LEFT}));
+  tm.addTransition(Transition("c", {'y'}, "c", {'y'}, {Movement::LEFT}));
+  tm.addTransition(Transition("c", {'.'}, "f", {'.'}, {Movement::STAY}));
+  tm.compile();
+  return tm;
+}
+
+}  // namespace
+
+int main() {
+  const std::string input(18, 'a');
+  TuringMachine tm = guessingMachine();
+
+  for (SearchMode mode : {SearchMode::BREADTH_FIRST, SearchMode::ITERATIVE_DEEPENING}) {
+    for (size_t jobs : {1, 2, 4, 8}) {
+      NondeterministicSearch search(mode, jobs, NondeterministicSearch::kDefaultMemoryLimit);
+      auto start = std::chrono::steady_clock::now();
+      SearchResult result = search.run(*tm.getProgram(), input, 1000);
+      double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      std::printf("%-6s %zu hilos %10zu configuraciones %8.3f s %12.0f conf/s  (%zu pasos, %s)\n",
+                  mode == SearchMode::BREADTH_FIRST ? "bfs" : "iddfs", jobs, result.configurations, elapsed,
+                  result.configurations / elapsed, result.steps,
+                  result.status == RunStatus::HALTED && tm.getProgram()->isFinal(result.state) ? "aceptada" : "rechazada");
+    }
+  }
+  return 0;
+}
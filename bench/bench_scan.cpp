@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../include/SymbolSet.hpp"
+#include "../include/TuringMachine.hpp"
+
+/**
+ * @brief Benchmark de los bucles de barrido
+ *
+ * Ejecuta una máquina de zigzag (marca la primera 'a', recorre hasta el final y vuelve) sobre
+ * a^n, cuyo número de pasos crece con n² y que pasa casi todo el tiempo en bucles de barrido,
+ * y compara SymbolSet::spanForward con el recorrido celda a celda.
+ */
+
+namespace {
+
+double seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+TuringMachine zigzagMachine() {
+  Alphabet sigma(std::set<char>{'a'});
+  Alphabet gamma(std::set<char>{'a', 'X', '.'});
+  TuringMachine tm({"q0", "q1", "q2"}, sigma, gamma, "q0", '.', {"q0"}, 1);
+  auto add = [&](const char* from, char read, const char* to, char write, Movement move) {
+    tm.addTransition(Transition(from, {read}, to, {write}, {move}));
+  };
+  add("q0", 'a', "q1", 'X', Movement::RIGHT);
+  add("q1", 'a', "q1", 'a', Movement::RIGHT);
+  add("q1", '.', "q2", '.', Movement::LEFT);
+  add("q2", 'a', "q2", 'a', Movement::LEFT);
+  add("q2", 'X', "q0", 'X', Movement::RIGHT);
+  tm.compile();
+  return tm;
+}
+
+void runZigzag(TapeStorage storage, const char* name) {
+  for (size_t n : {1000, 4000, 16000}) {
+    TuringMachine tm = zigzagMachine();
+    tm.setTapeStorage(0, storage);
+    auto start = std::chrono::steady_clock::now();
+    tm.run(std::string(n, 'a'), size_t(1) << 40);
+    double elapsed = seconds(start);
+    std::printf("%-12s n=%-6zu %14zu pasos %10.3f ms %14.3e pasos/s\n", name, n, tm.getStepCount(),
+                elapsed * 1e3, tm.getStepCount() / elapsed);
+  }
+}
+
+void runSpan() {
+  const size_t kCells = size_t(1) << 20;
+  const size_t kRounds = 200;
+  std::string cells(kCells, 'a');
+  cells.back() = '.';
+  SymbolSet symbols;
+  symbols.insert('a');
+
+  size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < kRounds; ++r) {
+    size_t i = 0;
+    while (i < kCells && symbols.contains(cells[i])) {
+      i++;
+    }
+    checksum += i;
+  }
+  double scalar = seconds(start);
+
+  start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < kRounds; ++r) {
+    checksum += symbols.spanForward(cells.data(), kCells);
+  }
+  double vector = seconds(start);
+
+  double total = static_cast<double>(kCells) * kRounds;
+  std::printf("%-12s %10.3f ns/celda\n", "celda a celda", scalar * 1e9 / total);
+  std::printf("%-12s %10.3f ns/celda  (checksum %zu)\n", "spanForward", vector * 1e9 / total, checksum);
+}
+
+}  // namespace
+
+int main() {
+  runZigzag(TapeStorage::CONTIGUOUS, "contigua");
+  runZigzag(TapeStorage::RUN_LENGTH, "tramos");
+  runZigzag(TapeStorage::PACKED, "empaquetada");
+  runSpan();
+  return 0;
+}
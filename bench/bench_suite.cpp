@@ -0,0 +1,448 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/FileParser.hpp"
+#include "../include/TuringMachine.hpp"
+
+/**
+ * @brief Batería de benchmarks con comparación contra una línea base
+ *
+ * Ejecuta un conjunto fijo de cargas (las máquinas de data/Definitions, sumadores y
+ * multiplicadores unarios generados, campeones de castor afanoso y máquinas sintéticas con
+ * tablas δ grandes o muchas cintas) y, para cada una, mide pasos/s, ns/paso, celdas de cinta
+ * máximas y reservas de memoria de una ejecución en frío. Compara los resultados con la línea
+ * base en JSON y termina con error si alguna carga es más lenta que la tolerancia admitida o
+ * reserva más memoria que en la línea base.
+ *
+ * Cada ronda cronometrada va precedida de un bucle de calibración fijo, y lo que se compara es la
+ * mediana de las rondas del cociente entre los ns/paso de la carga y los ns/iteración de la
+ * calibración: así la comparación no depende de la velocidad de la máquina ni de la carga del
+ * sistema en ese momento, que afectan por igual a las dos medidas. Una carga que supera la
+ * tolerancia se vuelve a medir hasta kConfirmations veces y solo se informa como lenta si todas
+ * las medidas la superan, de modo que una interferencia puntual no se toma por una regresión.
+ *
+ * Uso: bench_suite [--baseline ruta] [--tolerance t] [--update-baseline]
+ */
+
+namespace {
+
+std::atomic<size_t> allocation_count(0);
+
+}  // namespace
+
+// Contador global de reservas de memoria (solo en este binario). GCC avisa de malloc/free
+// emparejados con new/delete al expandir estos operadores en línea, pero aquí es intencionado.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+const double kMinRoundSeconds = 0.1;
+const size_t kRounds = 7;
+const size_t kCalibrationIterations = size_t(1) << 22;
+const size_t kConfirmations = 2;
+
+/**
+ * @brief Carga de trabajo: máquina, entrada y límite de pasos por ejecución
+ */
+struct Workload {
+  std::string name;
+  std::function<TuringMachine()> build;
+  std::string input;
+  size_t max_steps;
+};
+
+/**
+ * @brief Resultado de una carga
+ */
+struct Measurement {
+  size_t steps = 0;
+  double ns_per_step = 0;
+  double relative = 0;   // ns/paso entre ns/iteración de la calibración
+  size_t peak_cells = 0;
+  size_t allocations = 0;
+};
+
+double seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Bucle de calibración: búsquedas dependientes en una tabla pequeña, como el despacho de δ
+ * @return ns por iteración
+ */
+double calibrate() {
+  static volatile uint32_t sink = 0;
+  uint32_t table[256];
+  for (uint32_t i = 0; i < 256; ++i) {
+    table[i] = i * 2654435761u;
+  }
+  uint32_t state = sink;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kCalibrationIterations; ++i) {
+    state = table[(state ^ static_cast<uint32_t>(i)) & 255] + (state >> 3);
+  }
+  double elapsed = seconds(start);
+  sink = state;
+  return elapsed * 1e9 / kCalibrationIterations;
+}
+
+/**
+ * @brief Mediana de una lista de valores
+ */
+double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+/**
+ * @brief Construye una máquina a partir de transiciones en el formato del fichero de definición
+ * @param states Estados (separados por espacios)
+ * @param sigma Alfabeto de entrada
+ * @param gamma Alfabeto de cinta
+ * @param finals Estados finales
+ * @param num_tapes Número de cintas
+ * @param rules Transiciones, una por elemento: "q a q' b R" (k símbolos, k escrituras y k movimientos)
+ */
+TuringMachine machine(const std::string& states, const std::string& sigma, const std::string& gamma,
+                      const std::string& finals, size_t num_tapes, const std::vector<std::string>& rules) {
+  auto split = [](const std::string& text) {
+    std::istringstream stream(text);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (stream >> token) {
+      tokens.push_back(token);
+    }
+    return tokens;
+  };
+  auto movement = [](const std::string& token) {
+    return token == "L" ? Movement::LEFT : token == "R" ? Movement::RIGHT : Movement::STAY;
+  };
+
+  std::vector<std::string> state_tokens = split(states);
+  std::vector<std::string> final_tokens = split(finals);
+  TuringMachine tm(std::set<std::string>(state_tokens.begin(), state_tokens.end()), Alphabet(split(sigma)),
+                   Alphabet(split(gamma)), state_tokens[0], '.',
+                   std::set<std::string>(final_tokens.begin(), final_tokens.end()), num_tapes);
+  for (const auto& rule : rules) {
+    std::vector<std::string> tokens = split(rule);
+    std::vector<char> read, write;
+    std::vector<Movement> moves;
+    for (size_t i = 0; i < num_tapes; ++i) {
+      read.push_back(tokens[1 + i][0]);
+      write.push_back(tokens[2 + num_tapes + i][0]);
+      moves.push_back(movement(tokens[2 + 2 * num_tapes + i]));
+    }
+    tm.addTransition(Transition(tokens[0], read, tokens[1 + num_tapes], write, moves));
+  }
+  tm.compile();
+  return tm;
+}
+
+/**
+ * @brief Sumador unario: 1^n a 1^m → 1^(n+m)
+ */
+TuringMachine unaryAdder() {
+  return machine("q0 q1 q2 q3", "1 a", "1 a .", "q3", 1, {
+    "q0 1 q0 1 R", "q0 a q1 1 R", "q1 1 q1 1 R", "q1 . q2 . L", "q2 1 q3 . S",
+  });
+}
+
+/**
+ * @brief Multiplicador unario de dos cintas: a^n b^m en la cinta 1 → 1^(n·m) en la cinta 2
+ */
+TuringMachine unaryMultiplier() {
+  return machine("q0 q1 q2 q3 q4", "a b", "a b X 1 .", "q4", 2, {
+    "q0 a . q1 X . R S", "q0 b . q4 b . S S", "q0 . . q4 . . S S",
+    "q1 a . q1 a . R S", "q1 b . q2 b . S S",
+    "q2 b . q2 b 1 R R", "q2 . . q3 . . L S",
+    "q3 b . q3 b . L S", "q3 a . q3 a . L S", "q3 X . q0 X . R S",
+  });
+}
+
+/**
+ * @brief Campeón del castor afanoso de 4 estados (107 pasos)
+ */
+TuringMachine busyBeaver4() {
+  return machine("A B C D H", "1", "1 .", "H", 1, {
+    "A . B 1 R", "A 1 B 1 L", "B . A 1 L", "B 1 C . L",
+    "C . H 1 R", "C 1 D 1 L", "D . D 1 R", "D 1 A . R",
+  });
+}
+
+/**
+ * @brief Campeón del castor afanoso de 5 estados (47 176 870 pasos)
+ */
+TuringMachine busyBeaver5() {
+  return machine("A B C D E H", "1", "1 .", "H", 1, {
+    "A . B 1 R", "A 1 C 1 L", "B . C 1 R", "B 1 B 1 R", "C . D 1 R",
+    "C 1 E . L", "D . A 1 L", "D 1 D 1 L", "E . H 1 R", "E 1 A . L",
+  });
+}
+
+/**
+ * @brief Máquina sintética total (nunca se detiene) con estados aleatorios
+ * @param num_states Número de estados
+ * @param num_tapes Número de cintas
+ * @param symbols Alfabeto de cinta (el primero es el blanco)
+ */
+TuringMachine syntheticMachine(size_t num_states, size_t num_tapes, const std::string& symbols) {
+  std::mt19937 rng(12345);
+  std::string states;
+  for (size_t i = 0; i < num_states; ++i) {
+    states += "s" + std::to_string(i) + " ";
+  }
+  std::string gamma;
+  for (char symbol : symbols) {
+    gamma += std::string(1, symbol) + " ";
+  }
+
+  size_t combinations = 1;
+  for (size_t i = 0; i < num_tapes; ++i) {
+    combinations *= symbols.size();
+  }
+  const char* moves = "LR";
+  std::vector<std::string> rules;
+  for (size_t state = 0; state < num_states; ++state) {
+    for (size_t combination = 0; combination < combinations; ++combination) {
+      std::string read, write, move;
+      size_t code = combination;
+      for (size_t t = 0; t < num_tapes; ++t) {
+        read += std::string(1, symbols[code % symbols.size()]) + " ";
+        code /= symbols.size();
+        write += std::string(1, symbols[rng() % symbols.size()]) + " ";
+        move += std::string(1, moves[rng() % 2]) + " ";
+      }
+      rules.push_back("s" + std::to_string(state) + " " + read + "s" + std::to_string(rng() % num_states) + " " +
+                      write + move);
+    }
+  }
+  return machine(states, symbols.substr(1, 1), gamma, "", num_tapes, rules);
+}
+
+std::vector<Workload> workloads() {
+  auto definition = [](const std::string& path) {
+    return [path] { return FileParser::loadMachineDefinition(path, false); };
+  };
+  std::string binary;
+  std::mt19937 rng(7);
+  for (size_t i = 0; i < 20000; ++i) {
+    binary += static_cast<char>('0' + rng() % 2);
+  }
+  std::string ab;
+  for (size_t i = 0; i < 20000; ++i) {
+    ab += static_cast<char>('a' + rng() % 2);
+  }
+  const size_t kUnlimited = size_t(1) << 40;
+
+  return {
+    {"ejemplo_paridad", definition("data/Definitions/Ejemplo_MT.txt"), binary, kUnlimited},
+    {"ejemplo_doble", definition("data/Definitions/Ejemplo2_MT.txt"), std::string(300, '1'), kUnlimited},
+    {"problema1", definition("data/Definitions/Problema1_MT.txt"), std::string(5000, 'a') + std::string(5001, 'b'),
+     kUnlimited},
+    {"problema2", definition("data/Definitions/Problema2_MT.txt"), ab, kUnlimited},
+    {"sumador_unario", unaryAdder, std::string(50000, '1') + "a" + std::string(50000, '1'), kUnlimited},
+    {"multiplicador_unario", unaryMultiplier, std::string(200, 'a') + std::string(200, 'b'), kUnlimited},
+    {"castor_4", busyBeaver4, "", kUnlimited},
+    {"castor_5", busyBeaver5, "", kUnlimited},
+    {"delta_grande", [] { return syntheticMachine(4096, 1, ".abc"); }, "", 2000000},
+    {"ocho_cintas", [] { return syntheticMachine(8, 8, ".a"); }, "", 2000000},
+  };
+}
+
+/**
+ * @brief Mide una carga: una ejecución en frío (reservas y celdas) y varias rondas cronometradas
+ */
+Measurement measure(const Workload& workload) {
+  Measurement result;
+  TuringMachine prototype = workload.build();
+
+  {
+    TuringMachine tm(prototype);
+    size_t before = allocation_count.load();
+    tm.run(workload.input, workload.max_steps);
+    result.allocations = allocation_count.load() - before;
+    result.steps = tm.getStepCount();
+    for (const auto& tape : tm.getTapesContent()) {
+      result.peak_cells += tape.size();
+    }
+  }
+
+  std::vector<double> ns_per_step;
+  std::vector<double> relative;
+  for (size_t round = 0; round < kRounds; ++round) {
+    double calibration = calibrate();
+    TuringMachine tm(prototype);
+    size_t steps = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+      tm.run(workload.input, workload.max_steps);
+      steps += tm.getStepCount();
+      elapsed = seconds(start);
+    } while (elapsed < kMinRoundSeconds);
+    ns_per_step.push_back(elapsed * 1e9 / steps);
+    relative.push_back(ns_per_step.back() / calibration);
+  }
+  result.ns_per_step = median(ns_per_step);
+  result.relative = median(relative);
+  return result;
+}
+
+/**
+ * @brief Lee la línea base: {"carga": {"ns_per_step": x, "allocations": n, ...}, ...}
+ *
+ * Solo admite el formato que escribe writeBaseline (objetos con valores numéricos).
+ */
+std::map<std::string, std::map<std::string, double>> readBaseline(const std::string& path) {
+  std::map<std::string, std::map<std::string, double>> baseline;
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return baseline;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string text = buffer.str();
+
+  auto readString = [&text](size_t& position) {
+    size_t begin = text.find('"', position) + 1;
+    size_t end = text.find('"', begin);
+    position = end + 1;
+    return text.substr(begin, end - begin);
+  };
+
+  size_t position = text.find('{') + 1;
+  while (true) {
+    size_t quote = text.find('"', position);
+    if (quote == std::string::npos) {
+      break;
+    }
+    std::string name = readString(position);
+    size_t close = text.find('}', position);
+    while (true) {
+      size_t field = text.find('"', position);
+      if (field == std::string::npos || field > close) {
+        break;
+      }
+      std::string key = readString(position);
+      position = text.find(':', position) + 1;
+      baseline[name][key] = std::strtod(text.c_str() + position, nullptr);
+    }
+    position = close + 1;
+  }
+  return baseline;
+}
+
+void writeBaseline(const std::string& path, const std::vector<Workload>& loads, const std::vector<Measurement>& results) {
+  std::ofstream file(path);
+  file << "{\n";
+  for (size_t i = 0; i < loads.size(); ++i) {
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "  \"%s\": {\"ns_per_step\": %.3f, \"relative\": %.4f, \"steps\": %zu, \"peak_cells\": %zu, "
+                  "\"allocations\": %zu}%s\n",
+                  loads[i].name.c_str(), results[i].ns_per_step, results[i].relative, results[i].steps,
+                  results[i].peak_cells, results[i].allocations, i + 1 < loads.size() ? "," : "");
+    file << line;
+  }
+  file << "}\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string baseline_path = "bench/baseline.json";
+  double tolerance = 0.5;
+  bool update = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--baseline" && i + 1 < argc) {
+      baseline_path = argv[++i];
+    } else if (arg == "--tolerance" && i + 1 < argc) {
+      tolerance = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--update-baseline") {
+      update = true;
+    } else {
+      std::fprintf(stderr, "Uso: %s [--baseline ruta] [--tolerance t] [--update-baseline]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<Workload> loads = workloads();
+  auto baseline = readBaseline(baseline_path);
+  std::vector<Measurement> results;
+  int status = 0;
+
+  std::printf("%-22s %12s %14s %10s %12s %8s %10s\n", "carga", "pasos", "pasos/s", "ns/paso", "celdas", "reservas",
+              "vs base");
+  for (const auto& load : loads) {
+    Measurement result = measure(load);
+
+    std::string verdict = "nueva";
+    auto it = baseline.find(load.name);
+    if (it != baseline.end()) {
+      // Las líneas base sin calibración se comparan en ns/paso absolutos
+      bool calibrated = it->second.count("relative") != 0;
+      double base = calibrated ? it->second["relative"] : it->second["ns_per_step"];
+      auto value = [calibrated](const Measurement& measurement) {
+        return calibrated ? measurement.relative : measurement.ns_per_step;
+      };
+      for (size_t i = 0; i < kConfirmations && value(result) > base * (1 + tolerance); ++i) {
+        Measurement retry = measure(load);
+        if (value(retry) < value(result)) {
+          result = retry;
+        }
+      }
+      double current = value(result);
+      char ratio[32];
+      std::snprintf(ratio, sizeof(ratio), "%+.0f%%", (current / base - 1) * 100);
+      verdict = ratio;
+      if (current > base * (1 + tolerance)) {
+        verdict += " LENTA";
+        status = 1;
+      }
+      if (result.allocations > it->second["allocations"]) {
+        verdict += " RESERVAS";
+        status = 1;
+      }
+    }
+    results.push_back(result);
+    std::printf("%-22s %12zu %14.3e %10.3f %12zu %8zu %10s\n", load.name.c_str(), result.steps,
+                1e9 / result.ns_per_step, result.ns_per_step, result.peak_cells, result.allocations, verdict.c_str());
+  }
+
+  if (update) {
+    writeBaseline(baseline_path, loads, results);
+    std::printf("Línea base actualizada: %s\n", baseline_path.c_str());
+    return 0;
+  }
+  if (status != 0) {
+    std::printf("Regresión respecto a %s (tolerancia %.0f%%)\n", baseline_path.c_str(), tolerance * 100);
+  }
+  return status;
+}
@@ -0,0 +1,204 @@
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <set>
+#include <string>
+#include "../include/PackedTape.hpp"
+#include "../include/RunLengthTape.hpp"
+#include "../include/Tape.hpp"
+
+/**
+ * @brief Microbenchmark de la cinta: barridos largos izquierda/derecha y lotes de reset()
+ *
+ * Compara la cinta contigua (Tape) con la implementación anterior basada en std::deque<char>,
+ * reproducida aquí como DequeTape, con la cinta por tramos (RunLengthTape) y con la cinta
+ * empaquetada (PackedTape, 4 bits por celda con el alfabeto de las pruebas). Mide además la
+ * extracción del resultado de una cinta larga casi en blanco: copia completa y recorte frente a
+ * la vista del tramo no blanco.
+ */
+
+namespace {
+
+/**
+ * @brief Cinta sobre std::deque<char> (implementación anterior de Tape)
+ */
+class DequeTape {
+public:
+  explicit DequeTape(char blank_symbol) : blank_symbol_(blank_symbol), head_position_(1) { reset(""); }
+
+  char read() const { return tape_[head_position_]; }
+
+  void write(char symbol) {
+    tape_[head_position_] = symbol;
+    if (head_position_ == 0 && tape_[0] != blank_symbol_) {
+      expandLeft();
+    }
+    if (head_position_ == static_cast<int>(tape_.size()) - 1 && tape_[head_position_] != blank_symbol_) {
+      expandRight();
+    }
+  }
+
+  void moveLeft() {
+    if (head_position_ == 0) {
+      expandLeft();
+    }
+    head_position_--;
+  }
+
+  void moveRight() {
+    head_position_++;
+    if (head_position_ >= static_cast<int>(tape_.size())) {
+      expandRight();
+    }
+  }
+
+  void reset(const std::string& input) {
+    tape_.clear();
+    head_position_ = 1;
+    tape_.push_back(blank_symbol_);
+    if (input.empty()) {
+      tape_.push_back(blank_symbol_);
+    } else {
+      for (char c : input) {
+        tape_.push_back(c);
+      }
+    }
+    tape_.push_back(blank_symbol_);
+  }
+
+private:
+  std::deque<char> tape_;
+  char blank_symbol_;
+  int head_position_;
+
+  void expandLeft() {
+    tape_.push_front(blank_symbol_);
+    head_position_++;
+  }
+
+  void expandRight() { tape_.push_back(blank_symbol_); }
+};
+
+double seconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Barridos de ida y vuelta cada vez más largos, escribiendo en cada celda
+ * @return Número de movimientos realizados
+ */
+template <typename TapeType>
+size_t sweeps(TapeType& tape, size_t rounds, size_t& checksum) {
+  size_t moves = 0;
+  for (size_t r = 1; r <= rounds; ++r) {
+    size_t width = r * 1024;
+    for (size_t i = 0; i < width; ++i, ++moves) {
+      checksum += static_cast<unsigned char>(tape.read());
+      tape.write('a');
+      tape.moveRight();
+    }
+    for (size_t i = 0; i < 2 * width; ++i, ++moves) {
+      checksum += static_cast<unsigned char>(tape.read());
+      tape.write('b');
+      tape.moveLeft();
+    }
+  }
+  return moves;
+}
+
+/**
+ * @brief Lote de entradas: reset() seguido de un recorrido corto sobre la entrada
+ * @return Número de movimientos realizados
+ */
+template <typename TapeType>
+size_t batch(TapeType& tape, size_t inputs, size_t& checksum) {
+  const std::string input(200, 'a');
+  size_t moves = 0;
+  for (size_t n = 0; n < inputs; ++n) {
+    tape.reset(input);
+    for (size_t i = 0; i < input.size() + 8; ++i, ++moves) {
+      checksum += static_cast<unsigned char>(tape.read());
+      tape.write('x');
+      tape.moveRight();
+    }
+  }
+  return moves;
+}
+
+/**
+ * @brief Contador unario: escribe una racha larga de unos, como la salida de Problema2_MT
+ * @return Número de movimientos realizados
+ */
+template <typename TapeType>
+size_t unary(TapeType& tape, size_t length, size_t& checksum) {
+  tape.reset("");
+  for (size_t i = 0; i < length; ++i) {
+    tape.write('1');
+    tape.moveRight();
+  }
+  checksum += static_cast<size_t>(tape.getHeadPosition());
+  return length;
+}
+
+template <typename TapeType>
+void report(const char* name, const char* workload, size_t (*body)(TapeType&, size_t, size_t&), size_t amount,
+            TapeType tape = TapeType('.')) {
+  size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  size_t moves = body(tape, amount, checksum);
+  double elapsed = seconds(start);
+  std::printf("%-12s %-10s %12zu movs %10.3f ns/mov  (checksum %zu)\n", name, workload, moves,
+              elapsed * 1e9 / moves, checksum);
+}
+
+/**
+ * @brief Extracción repetida del resultado de una cinta de 2^20 celdas con 16 no blancas
+ */
+void extraction() {
+  const size_t kExtractions = 2000;
+  Tape tape('.');
+  for (size_t i = 0; i < (size_t(1) << 20); ++i) {
+    tape.moveRight();
+  }
+  for (size_t i = 0; i < 16; ++i) {
+    tape.write('a');
+    tape.moveLeft();
+  }
+
+  size_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t n = 0; n < kExtractions; ++n) {
+    std::string content = tape.getContent();
+    size_t first = content.find_first_not_of('.');
+    checksum += content.substr(first, content.find_last_not_of('.') - first + 1).size();
+  }
+  std::printf("%-12s %-10s %12zu extr %10.3f ns/extr  (checksum %zu)\n", "contigua", "copia", kExtractions,
+              seconds(start) * 1e9 / kExtractions, checksum);
+
+  checksum = 0;
+  start = std::chrono::steady_clock::now();
+  for (size_t n = 0; n < kExtractions; ++n) {
+    checksum += tape.getNonBlankView().size();
+  }
+  std::printf("%-12s %-10s %12zu extr %10.3f ns/extr  (checksum %zu)\n", "contigua", "vista", kExtractions,
+              seconds(start) * 1e9 / kExtractions, checksum);
+}
+
+}  // namespace
+
+int main() {
+  const PackedTape packed('.', Alphabet(std::set<char>{'.', 'a', 'b', 'x', '1'}));
+  report<DequeTape>("deque", "barridos", sweeps<DequeTape>, 200);
+  report<Tape>("contigua", "barridos", sweeps<Tape>, 200);
+  report<DequeTape>("deque", "lote", batch<DequeTape>, 100000);
+  report<Tape>("contigua", "lote", batch<Tape>, 100000);
+  report<RunLengthTape>("tramos", "barridos", sweeps<RunLengthTape>, 200);
+  report<RunLengthTape>("tramos", "lote", batch<RunLengthTape>, 100000);
+  report<PackedTape>("empaquetada", "barridos", sweeps<PackedTape>, 200, packed);
+  report<PackedTape>("empaquetada", "lote", batch<PackedTape>, 100000, packed);
+  report<Tape>("contigua", "unario", unary<Tape>, 100000000);
+  report<RunLengthTape>("tramos", "unario", unary<RunLengthTape>, 100000000);
+  report<PackedTape>("empaquetada", "unario", unary<PackedTape>, 100000000, packed);
+  extraction();
+  return 0;
+}
@@ -0,0 +1,572 @@
+// Generado por mt_compile a partir de data/Definitions/Problema2_MT.txt. No editar.
+// Compilar con: make native DEF=<definition_file> (o g++ -std=c++17 -O2 -I<include del proyecto>)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "SymbolSet.hpp"
+
+namespace {
+
+const size_t kNumTapes = 2;
+const char kBlank = '.';
+
+const char* const kStateNames[] = {
+  "q0", "q1", "q2", "q3", "q4", "q5", "q6", "q7",
+};
+
+const bool kFinal[] = {
+  false, false, false, false, false, false, false, true,
+};
+
+// Símbolos del alfabeto de entrada Σ
+const bool kInputSymbols[256] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+/**
+ * @brief Cinta: buffer contiguo cuya parte usada es [begin_, end_); al alcanzar un extremo del
+ * buffer este duplica su capacidad hacia ese lado
+ */
+class Tape {
+public:
+  Tape() : buffer_(64, kBlank), begin_(32), end_(32), head_(32), origin_(32) {}
+
+  void reset(const char* input, size_t size) {
+    std::fill(buffer_.begin() + begin_, buffer_.begin() + end_, kBlank);
+    size_t length = std::max<size_t>(size, 1) + 2;
+    while (origin_ + length > buffer_.size()) {
+      buffer_.resize(buffer_.size() * 2, kBlank);
+    }
+    begin_ = origin_;
+    end_ = begin_ + length;
+    head_ = begin_ + 1;
+    std::copy(input, input + size, buffer_.begin() + head_);
+  }
+
+  char read() const { return buffer_[head_]; }
+
+  void write(char symbol) {
+    buffer_[head_] = symbol;
+    if (symbol != kBlank) {
+      if (head_ == begin_) {
+        expandLeft();
+      }
+      if (head_ == end_ - 1) {
+        expandRight();
+      }
+    }
+  }
+
+  void moveLeft() {
+    if (head_ == begin_) {
+      expandLeft();
+    }
+    head_--;
+  }
+
+  void moveRight() {
+    if (head_ == end_ - 1) {
+      expandRight();
+    }
+    head_++;
+  }
+
+  // Barridos: mover el cabezal mientras lea símbolos del conjunto (como Tape::scanLeft/scanRight)
+  size_t scanLeft(const SymbolSet& symbols, size_t limit) {
+    size_t moved = 0;
+    while (moved < limit) {
+      if (head_ == 0) {
+        growLeft();
+      }
+      size_t span = std::min(limit - moved, head_);
+      size_t count = symbols.spanBackward(buffer_.data() + head_, span);
+      head_ -= count;
+      moved += count;
+      if (count < span) {
+        break;
+      }
+    }
+    begin_ = std::min(begin_, head_);
+    return moved;
+  }
+
+  size_t scanRight(const SymbolSet& symbols, size_t limit) {
+    size_t moved = 0;
+    while (moved < limit) {
+      if (head_ == buffer_.size() - 1) {
+        buffer_.resize(buffer_.size() * 2, kBlank);
+      }
+      size_t span = std::min(limit - moved, buffer_.size() - 1 - head_);
+      size_t count = symbols.spanForward(buffer_.data() + head_, span);
+      head_ += count;
+      moved += count;
+      if (count < span) {
+        break;
+      }
+    }
+    end_ = std::max(end_, head_ + 1);
+    return moved;
+  }
+
+  void appendWithHead(std::string& out) const {
+    out.append(buffer_.data() + begin_, head_ - begin_);
+    out += '[';
+    out += buffer_[head_];
+    out += ']';
+    out.append(buffer_.data() + head_ + 1, end_ - head_ - 1);
+  }
+
+private:
+  std::vector<char> buffer_;
+  size_t begin_;
+  size_t end_;
+  size_t head_;
+  size_t origin_;
+
+  void expandLeft() {
+    if (begin_ == 0) {
+      growLeft();
+    }
+    begin_--;
+  }
+
+  void growLeft() {
+    size_t added = buffer_.size();
+    buffer_.insert(buffer_.begin(), added, kBlank);
+    begin_ += added;
+    end_ += added;
+    head_ += added;
+    origin_ += added;
+  }
+
+  void expandRight() {
+    if (end_ == buffer_.size()) {
+      buffer_.resize(buffer_.size() * 2, kBlank);
+    }
+    end_++;
+  }
+};
+
+/**
+ * @brief Resultado de una ejecución
+ */
+struct RunResult {
+  uint32_t state;
+  size_t steps;
+  bool halted;
+};
+
+// Conjuntos de los bucles de barrido
+SymbolSet MakeSymbolSet(const std::string& symbols) {
+  SymbolSet set;
+  for (char symbol : symbols) {
+    set.insert(symbol);
+  }
+  return set;
+}
+
+const SymbolSet kScan0 = MakeSymbolSet("b");
+const SymbolSet kScan1 = MakeSymbolSet("a");
+const SymbolSet kScan2 = MakeSymbolSet("1");
+
+/**
+ * @brief Ejecuta la máquina sobre las cintas ya inicializadas
+ *
+ * Cada estado es un bloque con etiqueta. Un paso sin transición aplicable detiene la máquina y
+ * cuenta como paso, igual que en MT.
+ */
+RunResult Run(Tape* tapes, size_t max_steps) {
+  size_t steps = 0;
+  uint32_t state;
+  goto s0;
+
+// q0
+s0:
+  if (steps >= max_steps) {
+    state = 0;
+    goto limit;
+  }
+  switch (tapes[0].read()) {
+    case 'a':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[1].write('1');
+          tapes[1].moveRight();
+          ++steps;
+          goto s1;
+      }
+      break;
+    case 'b':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[1].write('1');
+          tapes[1].moveRight();
+          ++steps;
+          goto s1;
+      }
+      break;
+  }
+  state = 0;
+  ++steps;
+  goto halt;
+
+// q1
+s1:
+  if (steps >= max_steps) {
+    state = 1;
+    goto limit;
+  }
+  switch (tapes[0].read()) {
+    case '.':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[1].moveRight();
+          ++steps;
+          goto s2;
+      }
+      break;
+    case 'a':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[0].moveRight();
+          tapes[1].write('1');
+          tapes[1].moveRight();
+          ++steps;
+          goto s1;
+      }
+      break;
+    case 'b':
+      switch (tapes[1].read()) {
+        case '.':
+          steps += tapes[0].scanRight(kScan0, max_steps - steps);
+          goto s1;
+      }
+      break;
+  }
+  state = 1;
+  ++steps;
+  goto halt;
+
+// q2
+s2:
+  if (steps >= max_steps) {
+    state = 2;
+    goto limit;
+  }
+  switch (tapes[0].read()) {
+    case '.':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[0].moveLeft();
+          tapes[1].write('1');
+          tapes[1].moveRight();
+          ++steps;
+          goto s3;
+      }
+      break;
+  }
+  state = 2;
+  ++steps;
+  goto halt;
+
+// q3
+s3:
+  if (steps >= max_steps) {
+    state = 3;
+    goto limit;
+  }
+  switch (tapes[0].read()) {
+    case '.':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[1].write('X');
+          tapes[1].moveLeft();
+          ++steps;
+          goto s4;
+      }
+      break;
+    case 'a':
+      switch (tapes[1].read()) {
+        case '.':
+          steps += tapes[0].scanLeft(kScan1, max_steps - steps);
+          goto s3;
+      }
+      break;
+    case 'b':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[0].moveLeft();
+          tapes[1].write('1');
+          tapes[1].moveRight();
+          ++steps;
+          goto s3;
+      }
+      break;
+  }
+  state = 3;
+  ++steps;
+  goto halt;
+
+// q4
+s4:
+  if (steps >= max_steps) {
+    state = 4;
+    goto limit;
+  }
+  switch (tapes[0].read()) {
+    case '.':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[1].moveLeft();
+          ++steps;
+          goto s5;
+        case '1':
+          steps += tapes[1].scanLeft(kScan2, max_steps - steps);
+          goto s4;
+      }
+      break;
+  }
+  state = 4;
+  ++steps;
+  goto halt;
+
+// q5
+s5:
+  if (steps >= max_steps) {
+    state = 5;
+    goto limit;
+  }
+  switch (tapes[0].read()) {
+    case '.':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[0].moveRight();
+          tapes[1].moveRight();
+          ++steps;
+          goto s6;
+        case '1':
+          steps += tapes[1].scanLeft(kScan2, max_steps - steps);
+          goto s5;
+      }
+      break;
+  }
+  state = 5;
+  ++steps;
+  goto halt;
+
+// q6
+s6:
+  if (steps >= max_steps) {
+    state = 6;
+    goto limit;
+  }
+  switch (tapes[0].read()) {
+    case '.':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[0].moveRight();
+          tapes[1].moveRight();
+          ++steps;
+          goto s6;
+        case '1':
+          tapes[0].write('1');
+          tapes[0].moveRight();
+          tapes[1].moveRight();
+          ++steps;
+          goto s6;
+        case 'X':
+          tapes[0].moveLeft();
+          tapes[1].write('.');
+          tapes[1].moveLeft();
+          ++steps;
+          goto s7;
+      }
+      break;
+    case 'a':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[0].write('.');
+          tapes[0].moveRight();
+          tapes[1].moveRight();
+          ++steps;
+          goto s6;
+        case '1':
+          tapes[0].write('1');
+          tapes[0].moveRight();
+          tapes[1].moveRight();
+          ++steps;
+          goto s6;
+      }
+      break;
+    case 'b':
+      switch (tapes[1].read()) {
+        case '.':
+          tapes[0].write('.');
+          tapes[0].moveRight();
+          tapes[1].moveRight();
+          ++steps;
+          goto s6;
+        case '1':
+          tapes[0].write('1');
+          tapes[0].moveRight();
+          tapes[1].moveRight();
+          ++steps;
+          goto s6;
+      }
+      break;
+  }
+  state = 6;
+  ++steps;
+  goto halt;
+
+// q7
+s7:
+  if (steps >= max_steps) {
+    state = 7;
+    goto limit;
+  }
+  state = 7;
+  ++steps;
+  goto halt;
+
+halt:
+  return {state, steps, true};
+limit:
+  return {state, steps, false};
+}
+
+/**
+ * @brief Vuelca el buffer de salida
+ */
+void Flush(std::string& out) {
+  std::fwrite(out.data(), 1, out.size(), stdout);
+  out.clear();
+  std::fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t kBufferSize = 1 << 20;
+  size_t max_steps = 10000;
+  std::vector<std::string> positional;
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i) {
+    std::string arg = argv[i];
+    std::string value;
+    if (arg.rfind("--max-steps=", 0) == 0) {
+      value = arg.substr(12);
+    } else if (arg == "--max-steps" && i + 1 < argc) {
+      value = argv[++i];
+    } else if (arg.rfind("--", 0) == 0) {
+      valid = false;
+      break;
+    } else {
+      positional.push_back(arg);
+      continue;
+    }
+    valid = !value.empty() && value.find_first_not_of("0123456789") == std::string::npos;
+    if (valid) {
+      try {
+        max_steps = std::stoull(value);
+      } catch (const std::exception&) {
+        valid = false;
+      }
+      valid = valid && max_steps >= 1;
+    }
+  }
+  if (!valid || positional.size() != 1) {
+    std::cerr << "Uso: " << argv[0] << " [--max-steps N] <input_file>\n";
+    return 1;
+  }
+
+  std::ifstream file(positional[0], std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Error: No se pudo abrir el archivo de entrada: " << positional[0] << std::endl;
+    return 1;
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  const std::string data = content.str();
+
+  std::vector<Tape> tapes(kNumTapes);
+  std::string out;
+  out.reserve(kBufferSize + kBufferSize / 4);
+  size_t position = 0;
+  for (size_t index = 1; position < data.size(); ++index) {
+    size_t end = data.find('\n', position);
+    if (end == std::string::npos) {
+      end = data.size();
+    }
+    const char* input = data.data() + position;
+    size_t size = end - position;
+    position = end + 1;
+
+    out += "---------------------------------------------------\n";
+    out += "Cadena de entrada #";
+    out += std::to_string(index);
+    out += ": \"";
+    out.append(input, size);
+    out += "\"\n";
+    out += "---------------------------------------------------\n\n";
+
+    for (size_t i = 0; i < size; ++i) {
+      if (!kInputSymbols[static_cast<unsigned char>(input[i])]) {
+        Flush(out);
+        std::cerr << "Error: La cadena de entrada contiene símbolos que no pertenecen a Σ\n";
+        return 1;
+      }
+    }
+
+    for (size_t i = 0; i < kNumTapes; ++i) {
+      tapes[i].reset(input, i == 0 ? size : 0);
+    }
+    RunResult result = Run(tapes.data(), max_steps);
+
+    if (!result.halted) {
+      out += "La máquina excedió el número máximo de pasos\n\n";
+    }
+    out += "Resultado: ";
+    out += kFinal[result.state] ? "ACEPTADA" : "RECHAZADA";
+    out += "\nEstado final: ";
+    out += kStateNames[result.state];
+    out += "\nPasos ejecutados: ";
+    out += std::to_string(result.steps);
+    out += "\n\n";
+    for (size_t i = 0; i < kNumTapes; ++i) {
+      out += "Cinta ";
+      out += std::to_string(i + 1);
+      out += ": ";
+      tapes[i].appendWithHead(out);
+      out += "\n";
+    }
+    out += "\n";
+
+    if (out.size() >= kBufferSize) {
+      Flush(out);
+    }
+  }
+  Flush(out);
+  return 0;
+}
@@ -1,27 +1,44 @@
 #pragma once
 
+#include <cstdint>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
  * @brief Clase que representa un alfabeto de símbolos para una máquina de Turing.
- * 
- * Gestiona un conjunto de símbolos únicos representados como caracteres.
+ *
+ * Gestiona un conjunto de símbolos únicos representados como caracteres, guardados en un mapa de
+ * bits de 256 posiciones: contains() es una comprobación de un bit. Los símbolos se agrupan
+ * además en rangos de códigos consecutivos; si hay como mucho kMaxVectorRanges, containsAll()
+ * valida las cadenas con SSE2, 16 caracteres por comparación de cada rango.
  */
 class Alphabet {
 public:
+  static constexpr size_t kMaxVectorRanges = 8;
+
   Alphabet();
   Alphabet(const std::vector<std::string>& symbols);
   Alphabet(const std::set<char>& symbols);
-  
+
   void addSymbol(char symbol);
-  bool contains(char symbol) const;
-  const std::set<char>& getSymbols() const;
+  bool contains(char symbol) const {
+    unsigned char code = static_cast<unsigned char>(symbol);
+    return (bits_[code >> 6] >> (code & 63)) & 1;
+  }
+  bool containsAll(std::string_view text) const;
+  std::string getSymbols() const;
   size_t size() const;
   bool isEmpty() const;
   std::string toString() const;
 
 private:
-  std::set<char> symbols_;
+  uint64_t bits_[4];
+  size_t size_;
+  unsigned char range_first_[kMaxVectorRanges];
+  unsigned char range_length_[kMaxVectorRanges];   // Códigos del rango menos uno
+  size_t num_ranges_;
+
+  void findRanges();
 };
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/**
+ * @brief Cola acotada sin bloqueos para varios productores y varios consumidores.
+ *
+ * Implementa el esquema de Vyukov: un buffer circular de capacidad potencia de dos en el que
+ * cada celda lleva un número de secuencia que indica si está libre para escribir o lista para
+ * leer. tryPush/tryPop nunca bloquean; push/pop esperan con espera activa decreciente
+ * (reintento, yield y pausas cortas), de modo que un productor más rápido que el consumidor
+ * queda frenado por la capacidad de la cola (contrapresión).
+ */
+template <typename T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity);
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  bool tryPush(T& value);
+  bool tryPop(T& value);
+  void push(T value);
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_;
+  alignas(64) std::atomic<size_t> enqueue_position_;
+  alignas(64) std::atomic<size_t> dequeue_position_;
+};
+
+/**
+ * @brief Espera progresiva para los bucles de reintento de las colas
+ */
+class Backoff {
+public:
+  Backoff() : attempts_(0) {}
+
+  void pause() {
+    if (attempts_ < 64) {
+      ++attempts_;
+    } else if (attempts_ < 128) {
+      ++attempts_;
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+  void reset() { attempts_ = 0; }
+
+private:
+  unsigned attempts_;
+};
+
+/**
+ * @brief Crea la cola
+ * @param capacity Capacidad mínima (se redondea a la siguiente potencia de dos)
+ */
+template <typename T>
+BoundedQueue<T>::BoundedQueue(size_t capacity)
+  : mask_(0), enqueue_position_(0), dequeue_position_(0) {
+  size_t size = 2;
+  while (size < capacity) {
+    size *= 2;
+  }
+  cells_.reset(new Cell[size]);
+  for (size_t i = 0; i < size; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mask_ = size - 1;
+}
+
+/**
+ * @brief Intenta encolar un elemento sin bloquear
+ * @param value Elemento (se mueve a la cola solo si hay sitio)
+ * @return false si la cola está llena
+ */
+template <typename T>
+bool BoundedQueue<T>::tryPush(T& value) {
+  size_t position = enqueue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell& cell = cells_[position & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (difference == 0) {
+      if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        cell.value = std::move(value);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Intenta desencolar un elemento sin bloquear
+ * @param value Elemento desencolado
+ * @return false si la cola está vacía
+ */
+template <typename T>
+bool BoundedQueue<T>::tryPop(T& value) {
+  size_t position = dequeue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell& cell = cells_[position & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+    if (difference == 0) {
+      if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        value = std::move(cell.value);
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = dequeue_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Encola un elemento esperando mientras la cola esté llena
+ * @param value Elemento a encolar
+ */
+template <typename T>
+void BoundedQueue<T>::push(T value) {
+  Backoff backoff;
+  while (!tryPush(value)) {
+    backoff.pause();
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "TuringMachine.hpp"
+
+/**
+ * @brief Punto de control de una ejecución en curso.
+ *
+ * Guarda en un fichero binario la configuración completa de la máquina a mitad de una
+ * ejecución: estado, pasos ejecutados, contenido y posición del cabezal de cada cinta, y la
+ * cadena de entrada con su posición en el fichero de entrada. Al restaurarlo, advance() continúa
+ * la ejecución con exactamente los mismos pasos que si no se hubiera interrumpido.
+ *
+ * La cabecera guarda la versión del formato, el orden de bytes y una huella de la máquina
+ * (estados y δ), de modo que un punto de control nunca se restaura sobre otra máquina.
+ */
+class Checkpoint {
+public:
+  static constexpr uint32_t kVersion = 1;
+
+  static uint64_t fingerprint(const TuringMachine& machine);
+  static void write(const std::string& path, const TuringMachine& machine, size_t input_index,
+                    std::string_view input);
+  static size_t read(const std::string& path, TuringMachine& machine, std::string& input);
+
+private:
+  /**
+   * @brief Cabecera del punto de control; le siguen la cadena de entrada y, por cada cinta, la
+   *        posición del cabezal, el tamaño de la cinta, el inicio y la longitud del tramo entre el
+   *        primer y el último símbolo no blanco (uint64_t) y ese tramo: los blancos de los extremos
+   *        no se guardan
+   */
+  struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t num_tapes;
+    uint64_t machine_hash;
+    uint64_t input_index;
+    uint64_t input_size;
+    uint64_t step_count;
+    uint32_t state;
+    uint32_t reserved;
+  };
+
+  static constexpr char kMagic[4] = {'M', 'T', 'C', 'P'};
+  static constexpr uint32_t kByteOrder = 0x01020304;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "Alphabet.hpp"
+#include "SymbolSet.hpp"
+#include "Transition.hpp"
+#include "TransitionTable.hpp"
+
+/**
+ * @brief Representación intermedia compilada de una Máquina de Turing.
+ *
+ * Los estados se internan como enteros pequeños (índice en el orden de Q) y los símbolos de Γ
+ * como códigos para la tabla de despacho. Las transiciones se almacenan en un único array plano:
+ * un registro de tamaño fijo por transición con el estado siguiente, los k símbolos a escribir
+ * y los k movimientos. El ejecutor trabaja solo con identificadores; los nombres de los estados
+ * se recuperan únicamente para mostrar resultados.
+ *
+ * Si varias transiciones comparten estado y símbolos leídos (máquina no determinista), la tabla de
+ * despacho devuelve la primera en orden de definición y getAlternative() recorre las demás; el
+ * ejecutor determinista aplica siempre la primera y NondeterministicSearch explora todas.
+ *
+ * Las transiciones con comodines (ver Transition::kWildcard) se compilan tal cual, sin expandirlas:
+ * la clave conserva el comodín, la tabla de despacho las indexa por patrón y un comodín escrito
+ * se resuelve al aplicar la transición con getWriteSymbol(). Son alternativas entre sí solo las
+ * transiciones con la misma clave, comodines incluidos.
+ *
+ * Al compilar se detectan además los bucles de barrido: transiciones que vuelven al mismo estado,
+ * no modifican ninguna celda y mueven una sola cinta. Mientras el símbolo bajo ese cabezal siga
+ * en el conjunto de símbolos del barrido, la máquina repite el bucle, así que el ejecutor puede
+ * recorrer toda la racha de una vez (ScanLoop).
+ *
+ * Los registros, las claves (estado y símbolos leídos de cada transición) y la tabla densa pueden
+ * residir en una imagen binaria proyectada en memoria (ver MachineImage), que la máquina mantiene
+ * viva mientras exista.
+ *
+ * Los accesores del bucle de ejecución se definen en la cabecera para que puedan expandirse en línea.
+ */
+class CompiledMachine {
+public:
+  /**
+   * @brief Bucle de barrido: mover una cinta mientras lea símbolos del conjunto
+   */
+  struct ScanLoop {
+    size_t tape;
+    Movement movement;
+    SymbolSet symbols;
+  };
+
+  CompiledMachine(const std::set<std::string>& states,
+                  const Alphabet& tape_alphabet,
+                  const std::string& initial_state,
+                  char blank_symbol,
+                  const std::set<std::string>& final_states,
+                  size_t num_tapes,
+                  const std::vector<Transition>& transitions);
+
+  size_t getNumStates() const;
+  size_t getNumTapes() const;
+  size_t getNumTransitions() const;
+  size_t getNumScanLoops() const;
+  bool isDeterministic() const;
+  uint32_t getInitialState() const;
+  char getBlankSymbol() const;
+  uint32_t getStateIndex(const std::string& name) const;
+  const std::string& getStateName(uint32_t state) const;
+  Transition getTransition(size_t index) const;
+
+  bool isFinal(uint32_t state) const { return final_[state] != 0; }
+
+  int32_t findTransition(uint32_t state, const char* symbols) const { return table_.find(state, symbols); }
+
+  uint32_t getNextState(int32_t transition) const {
+    uint32_t next;
+    std::memcpy(&next, record(transition), sizeof(next));
+    return next;
+  }
+
+  const char* getWriteSymbols(int32_t transition) const {
+    return reinterpret_cast<const char*>(record(transition) + sizeof(uint32_t));
+  }
+
+  bool hasWildcards() const { return wildcards_; }
+
+  /**
+   * @brief Símbolo que escribe una transición en una cinta
+   * @param transition Transición aplicada
+   * @param tape Cinta
+   * @param read Símbolo leído en esa cinta, que es lo que escribe un comodín
+   * @return Símbolo a escribir
+   */
+  char getWriteSymbol(int32_t transition, size_t tape, char read) const {
+    char symbol = getWriteSymbols(transition)[tape];
+    return wildcards_ && symbol == Transition::kWildcard ? read : symbol;
+  }
+
+  Movement getMovement(int32_t transition, size_t tape) const {
+    return static_cast<Movement>(record(transition)[sizeof(uint32_t) + num_tapes_ + tape]);
+  }
+
+  int32_t getAlternative(int32_t transition) const {
+    return alternative_of_.empty() ? TransitionTable::kNoTransition : alternative_of_[transition];
+  }
+
+  const ScanLoop* getScanLoop(int32_t transition) const {
+    int32_t scan = scan_loop_of_[transition];
+    return scan < 0 ? nullptr : &scan_loops_[scan];
+  }
+
+private:
+  friend class MachineImage;
+
+  static constexpr size_t kMaxScanProbes = size_t(1) << 12;   // Combinaciones de cintas con comodín
+
+  std::vector<std::string> state_names_;
+  std::vector<uint8_t> final_;
+  uint32_t initial_state_;
+  char blank_symbol_;
+  size_t num_tapes_;
+  bool wildcards_;
+  size_t num_transitions_;
+  size_t record_size_;
+  size_t key_size_;
+  std::vector<uint8_t> records_;
+  std::vector<uint8_t> keys_;
+  const uint8_t* record_data_;
+  const uint8_t* key_data_;
+  TransitionTable table_;
+  std::vector<int32_t> scan_loop_of_;
+  std::vector<ScanLoop> scan_loops_;
+  std::vector<int32_t> alternative_of_;
+  std::shared_ptr<const void> storage_;
+
+  CompiledMachine();
+
+  const uint8_t* record(int32_t transition) const {
+    return record_data_ + static_cast<size_t>(transition) * record_size_;
+  }
+
+  uint32_t getKeyState(size_t transition) const {
+    uint32_t state;
+    std::memcpy(&state, key_data_ + transition * key_size_, sizeof(state));
+    return state;
+  }
+
+  const char* getKeySymbols(size_t transition) const {
+    return reinterpret_cast<const char*>(key_data_ + transition * key_size_ + sizeof(uint32_t));
+  }
+
+  bool isWildcard(char symbol) const { return wildcards_ && symbol == Transition::kWildcard; }
+  bool isScanStep(int32_t transition, uint32_t state, const char* symbols, size_t& tape) const;
+  void findWildcards(const Alphabet& tape_alphabet);
+  void buildTable(const Alphabet& tape_alphabet, const int32_t* external_dense);
+  void findScanLoops(const Alphabet& tape_alphabet);
+  void findAlternatives();
+};
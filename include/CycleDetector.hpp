@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Tape.hpp"
+#include "Transition.hpp"
+
+/**
+ * @brief Detector de configuraciones repetidas para demostrar que una ejecución no se detiene.
+ *
+ * Mantiene un hash de la configuración (estado, posición absoluta de cada cabezal y celdas no
+ * blancas de cada cinta) que se actualiza de forma incremental: cada escritura y cada movimiento
+ * solo modifican los términos de la celda o del cabezal afectados. Siguiendo el algoritmo de
+ * Brent, guarda una configuración de control en los pasos potencia de dos y la compara con las
+ * siguientes; si el hash coincide, se comparan las configuraciones completas, por lo que una
+ * colisión nunca da un falso positivo. Como la máquina es determinista, una configuración
+ * repetida implica que la ejecución no termina.
+ */
+class CycleDetector {
+public:
+  explicit CycleDetector(char blank_symbol);
+
+  void start(uint32_t state, const Tape* tapes, size_t num_tapes);
+  void write(size_t tape, char old_symbol, char new_symbol);
+  void move(size_t tape, Movement movement);
+  bool check(uint32_t state, const Tape* tapes);
+
+  size_t getPeriod() const;
+
+private:
+  /**
+   * @brief Configuración de control normalizada (sin blancos en los extremos)
+   */
+  struct Snapshot {
+    uint64_t hash;
+    uint32_t state;
+    std::vector<long> heads;
+    std::vector<long> first_cells;
+    std::vector<std::string> cells;
+  };
+
+  char blank_symbol_;
+  size_t num_tapes_;
+  uint64_t hash_;
+  std::vector<long> heads_;
+  Snapshot checkpoint_;
+  size_t power_;
+  size_t distance_;
+  size_t period_;
+
+  void takeSnapshot(Snapshot& snapshot, uint64_t hash, uint32_t state, const Tape* tapes) const;
+  bool matches(uint32_t state, const Tape* tapes) const;
+
+  static uint64_t mix(uint64_t value);
+  static uint64_t cellKey(size_t tape, long position, char symbol);
+  static uint64_t headKey(size_t tape, long position);
+  static uint64_t stateKey(uint32_t state);
+};
+
+/**
+ * @brief Actualiza el hash tras escribir en la celda bajo el cabezal
+ * @param tape Índice de la cinta
+ * @param old_symbol Símbolo que había en la celda
+ * @param new_symbol Símbolo escrito
+ */
+inline void CycleDetector::write(size_t tape, char old_symbol, char new_symbol) {
+  if (old_symbol == new_symbol) {
+    return;
+  }
+  if (old_symbol != blank_symbol_) {
+    hash_ ^= cellKey(tape, heads_[tape], old_symbol);
+  }
+  if (new_symbol != blank_symbol_) {
+    hash_ ^= cellKey(tape, heads_[tape], new_symbol);
+  }
+}
+
+/**
+ * @brief Actualiza el hash tras mover un cabezal
+ * @param tape Índice de la cinta
+ * @param movement Movimiento aplicado
+ */
+inline void CycleDetector::move(size_t tape, Movement movement) {
+  if (movement == Movement::STAY) {
+    return;
+  }
+  hash_ ^= headKey(tape, heads_[tape]);
+  heads_[tape] += movement == Movement::LEFT ? -1 : 1;
+  hash_ ^= headKey(tape, heads_[tape]);
+}
+
+/**
+ * @brief Comprueba la configuración actual tras un paso
+ * @param state Estado actual
+ * @param tapes Cintas de la máquina
+ * @return true si la configuración repite la configuración de control
+ */
+inline bool CycleDetector::check(uint32_t state, const Tape* tapes) {
+  uint64_t hash = hash_ ^ stateKey(state);
+  ++distance_;
+  if (hash == checkpoint_.hash && matches(state, tapes)) {
+    period_ = distance_;
+    return true;
+  }
+  if (distance_ == power_) {
+    takeSnapshot(checkpoint_, hash, state, tapes);
+    power_ *= 2;
+    distance_ = 0;
+  }
+  return false;
+}
+
+/**
+ * @brief Mezcla de bits de splitmix64
+ */
+inline uint64_t CycleDetector::mix(uint64_t value) {
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+/**
+ * @brief Término del hash de una celda no blanca
+ */
+inline uint64_t CycleDetector::cellKey(size_t tape, long position, char symbol) {
+  return mix((static_cast<uint64_t>(position) << 16) ^ (static_cast<uint64_t>(tape) << 8) ^
+             static_cast<unsigned char>(symbol));
+}
+
+/**
+ * @brief Término del hash de la posición de un cabezal
+ */
+inline uint64_t CycleDetector::headKey(size_t tape, long position) {
+  return mix(~((static_cast<uint64_t>(position) << 16) ^ static_cast<uint64_t>(tape)));
+}
+
+/**
+ * @brief Término del hash del estado
+ */
+inline uint64_t CycleDetector::stateKey(uint32_t state) {
+  return mix(0xC3A5C85C97CB3127ULL ^ state);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include "CompiledMachine.hpp"
+
+/**
+ * @brief Formatos de exportación del perfil de ejecución
+ */
+enum class ProfileFormat {
+  JSON,
+  CSV,
+  FOLDED   // Pilas plegadas ("q0;q1;q2 n") para herramientas de flame graphs
+};
+
+/**
+ * @brief Perfil de ejecución de una máquina: dónde se gastan los pasos.
+ *
+ * Acumula, para todas las ejecuciones perfiladas, los pasos dados en cada estado, las veces que
+ * se aplicó cada transición, el recorrido de cada cabezal (movimientos L/R) y las celdas que ha
+ * crecido cada cinta por cada extremo. Además cuenta cada paso según la secuencia de los últimos
+ * estados visitados (hasta kFoldedDepth), que se exporta como pilas plegadas: la raíz es el
+ * estado más antiguo y la hoja, el estado en el que se dio el paso.
+ *
+ * Los contadores de un paso se definen en la cabecera para que el bucle de ejecución pueda
+ * expandirlos en línea.
+ */
+class ExecutionProfile {
+public:
+  static constexpr size_t kFoldedDepth = 4;
+
+  ExecutionProfile() = default;
+  explicit ExecutionProfile(std::shared_ptr<const CompiledMachine> program);
+
+  void beginRun();
+  void step(uint32_t state, int32_t transition);
+  void move(size_t tape, Movement movement, size_t old_size, int old_head, size_t new_size, int new_head);
+  void merge(const ExecutionProfile& other);
+
+  uint64_t getSteps() const;
+  uint64_t getRuns() const;
+  uint64_t getStateHits(uint32_t state) const;
+  uint64_t getTransitionHits(size_t transition) const;
+  uint64_t getHeadTravel(size_t tape) const;
+
+  void write(std::ostream& out, ProfileFormat format) const;
+
+private:
+  /**
+   * @brief Contadores de una cinta
+   */
+  struct TapeCounters {
+    uint64_t travel = 0;
+    uint64_t expand_left = 0;
+    uint64_t expand_right = 0;
+  };
+
+  std::shared_ptr<const CompiledMachine> program_;
+  uint64_t steps_ = 0;
+  uint64_t runs_ = 0;
+  std::vector<uint64_t> state_hits_;
+  std::vector<uint64_t> transition_hits_;
+  std::vector<TapeCounters> tapes_;
+  std::unordered_map<uint64_t, uint64_t> folded_;
+  uint64_t stack_ = 0;
+  unsigned state_bits_ = 0;
+  size_t depth_ = 0;
+  uint64_t stack_mask_ = 0;
+
+  std::vector<uint32_t> unfold(uint64_t stack) const;
+  std::string transitionName(size_t transition) const;
+  void writeJson(std::ostream& out) const;
+  void writeCsv(std::ostream& out) const;
+  void writeFolded(std::ostream& out) const;
+};
+
+/**
+ * @brief Cuenta un paso
+ * @param state Estado en el que se da el paso
+ * @param transition Transición aplicada (TransitionTable::kNoTransition si la máquina se detiene)
+ */
+inline void ExecutionProfile::step(uint32_t state, int32_t transition) {
+  ++steps_;
+  ++state_hits_[state];
+  if (transition != TransitionTable::kNoTransition) {
+    ++transition_hits_[transition];
+  }
+  stack_ = ((stack_ << state_bits_) | (state + 1)) & stack_mask_;
+  ++folded_[stack_];
+}
+
+/**
+ * @brief Cuenta el movimiento de un cabezal y el crecimiento de su cinta en un paso
+ * @param tape Índice de la cinta
+ * @param movement Movimiento aplicado
+ * @param old_size Tamaño de la cinta antes del paso
+ * @param old_head Posición del cabezal (respecto al extremo izquierdo) antes del paso
+ * @param new_size Tamaño de la cinta después del paso
+ * @param new_head Posición del cabezal después del paso
+ *
+ * Crecer por la izquierda desplaza la posición relativa del cabezal, así que las celdas añadidas
+ * por la izquierda son la diferencia entre la posición obtenida y la esperada por el movimiento.
+ */
+inline void ExecutionProfile::move(size_t tape, Movement movement, size_t old_size, int old_head,
+                                   size_t new_size, int new_head) {
+  int delta = movement == Movement::LEFT ? -1 : movement == Movement::RIGHT ? 1 : 0;
+  TapeCounters& counters = tapes_[tape];
+  counters.travel += delta != 0;
+  if (new_size != old_size) {
+    uint64_t left = static_cast<uint64_t>(new_head - (old_head + delta));
+    counters.expand_left += left;
+    counters.expand_right += (new_size - old_size) - left;
+  }
+}
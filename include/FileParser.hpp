@@ -5,6 +5,7 @@
 #include <sstream>
 #include <vector>
 #include <stdexcept>
+#include "MachineOptimizer.hpp"
 #include "TuringMachine.hpp"
 
 
@@ -16,6 +17,9 @@
 class FileParser {
 public:
   static TuringMachine parseMachineDefinition(const std::string& filename);
+  static TuringMachine loadMachineDefinition(const std::string& filename, bool use_cache = true,
+                                             OptimizationLevel optimization = OptimizationLevel::NONE,
+                                             OptimizationReport* report = nullptr);
   static std::vector<std::string> parseInputStrings(const std::string& filename);
 
 private:
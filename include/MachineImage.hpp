@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "MachineOptimizer.hpp"
+#include "TuringMachine.hpp"
+
+/**
+ * @brief Formato binario versionado de una máquina compilada.
+ *
+ * La imagen contiene la máquina ya validada e internada: nombres de Q, estados finales, Σ, Γ,
+ * los registros de δ, las claves (estado y símbolos leídos), los bucles de barrido, las cadenas
+ * de alternativas y, si la tabla de despacho es densa, la propia tabla. Al cargarla se proyecta
+ * con mmap y los registros, las claves y la tabla densa se usan directamente desde la proyección,
+ * sin parsear el texto. La carga recorre aun así δ una vez: comprueba que los índices de estado,
+ * de transición, de bucle y los movimientos están en rango (una imagen dañada se rechaza),
+ * copia los bucles de barrido y las alternativas, e inserta en la tabla de despacho las claves
+ * con comodines y, si la tabla exacta no es densa, todas las claves.
+ *
+ * La máquina se guarda ya optimizada: la cabecera lleva el nivel de optimización con el que se
+ * generó y el informe de esa pasada, así que cargarla no repite la optimización ni recompila nada.
+ *
+ * La cabecera guarda la versión del formato, el orden de bytes, un hash del fichero de texto
+ * del que procede y el nivel de optimización, de modo que una imagen antigua, de otra definición
+ * o de otro nivel no se usa nunca.
+ */
+class MachineImage {
+public:
+  static constexpr uint32_t kVersion = 4;
+
+  static uint64_t hashSource(std::string_view source);
+  static bool isCurrent(const std::string& path, uint64_t source_hash, OptimizationLevel optimization);
+  static TuringMachine read(const std::string& path, OptimizationReport* report = nullptr);
+  static void write(const std::string& path, const TuringMachine& machine, uint64_t source_hash,
+                    OptimizationLevel optimization, const OptimizationReport& report);
+
+private:
+  /**
+   * @brief Cabecera de la imagen (todas las secciones empiezan en un desplazamiento múltiplo de 8)
+   */
+  struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t num_states;
+    uint64_t source_hash;
+    uint64_t image_size;
+    uint32_t num_tapes;
+    uint32_t num_transitions;
+    uint32_t initial_state;
+    uint32_t record_size;
+    uint32_t key_size;
+    uint32_t blank_symbol;
+    uint64_t names_offset;
+    uint64_t names_size;
+    uint64_t finals_offset;
+    uint64_t input_alphabet_offset;
+    uint64_t input_alphabet_size;
+    uint64_t tape_alphabet_offset;
+    uint64_t tape_alphabet_size;
+    uint64_t records_offset;
+    uint64_t keys_offset;
+    uint64_t dense_offset;
+    uint64_t dense_size;
+    uint64_t scan_loop_of_offset;    // Un int32_t por transición
+    uint64_t scan_loops_offset;      // Un ScanRecord por bucle de barrido
+    uint64_t num_scan_loops;
+    uint64_t alternatives_offset;    // Un int32_t por transición, o nada si es determinista
+    uint64_t alternatives_size;
+    uint32_t optimization;           // OptimizationLevel con el que se generó
+    uint32_t states_before;          // Informe de la optimización; el tamaño final es el de la imagen
+    uint32_t unreachable_states;
+    uint32_t merged_states;
+    uint32_t transitions_before;
+    uint32_t reserved;
+  };
+
+  /**
+   * @brief Bucle de barrido tal como se guarda en la imagen
+   */
+  struct ScanRecord {
+    uint32_t tape;
+    uint32_t movement;
+    uint64_t symbols[4];   // Mapa de bits de los símbolos del barrido
+  };
+
+  static constexpr char kMagic[4] = {'M', 'T', 'B', 'C'};
+  static constexpr uint32_t kByteOrder = 0x01020304;
+
+  static bool checkHeader(const Header& header, uint64_t file_size);
+};
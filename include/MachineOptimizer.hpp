@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include "TuringMachine.hpp"
+
+/**
+ * @brief Optimización que se aplica a una máquina al cargarla
+ */
+enum class OptimizationLevel {
+  NONE,           // La máquina tal como está definida
+  DEAD_CODE,      // Elimina los estados y transiciones muertos
+  MERGE_STATES    // Elimina el código muerto y fusiona los estados equivalentes
+};
+
+/**
+ * @brief Resultado de optimizar una máquina con MachineOptimizer::optimize()
+ */
+struct OptimizationReport {
+  size_t states_before = 0;
+  size_t states_after = 0;
+  size_t unreachable_states = 0;   // Estados eliminados por inalcanzables
+  size_t merged_states = 0;        // Estados eliminados por equivalentes a otro
+  size_t transitions_before = 0;
+  size_t transitions_after = 0;
+};
+
+/**
+ * @brief Pasada de optimización de una máquina recién cargada.
+ *
+ * Primero elimina el código muerto: calcula a la vez los estados alcanzables desde el inicial y
+ * los símbolos que pueden aparecer en cada cinta (Σ y el blanco en la primera, el blanco en las
+ * demás, más lo que escriban las transiciones vivas). Una transición está viva si su estado es
+ * alcanzable y cada símbolo que lee puede aparecer en su cinta; las demás no pueden dispararse
+ * nunca y se eliminan, igual que los estados inalcanzables.
+ *
+ * Con merge_states fusiona después los estados equivalentes por refinamiento de particiones
+ * (Moore): la partición inicial separa finales y no finales, y cada ronda separa los estados cuyas
+ * transiciones, en orden de definición y con el estado siguiente sustituido por su bloque, no
+ * coinciden. Cada bloque se sustituye por su representante (el inicial si pertenece al bloque y,
+ * si no, el primero en el orden de Q), así que los nombres de los estados mostrados pueden
+ * cambiar; sin fusión, todo estado por el que pasa una ejecución se conserva con su nombre.
+ *
+ * Las transiciones que comparten clave se conservan todas y en su orden, así que la máquina
+ * optimizada se comporta igual también como no determinista. Si la pasada no elimina nada, la
+ * máquina no se recompila.
+ */
+class MachineOptimizer {
+public:
+  static OptimizationReport optimize(TuringMachine& machine, bool merge_states = false);
+};
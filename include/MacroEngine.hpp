@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CompiledMachine.hpp"
+#include "Tape.hpp"
+
+/**
+ * @brief Motor de simulación por macro-máquina (símbolos de bloque).
+ *
+ * Agrupa las celdas de cada cinta en bloques de B celdas. Un macro-paso parte del estado, del
+ * bloque bajo cada cabezal y de la posición del cabezal dentro de su bloque, y ejecuta la máquina
+ * hasta que algún cabezal sale de su bloque o la máquina se detiene. El resultado (estado,
+ * bloques nuevos, posiciones, pasos y extremos visitados) se guarda en una caché, de modo que las
+ * siguientes apariciones de la misma configuración de bloque se resuelven con una sola búsqueda.
+ *
+ * Además, cuando un macro-paso atraviesa un bloque completo en una dirección sin cambiar de estado
+ * ni tocar las demás cintas, los bloques idénticos consecutivos se recorren de una vez
+ * (multiplicando los pasos), lo que permite avanzar miles de pasos por búsqueda en los barridos.
+ *
+ * El número de pasos y la configuración final (incluida la extensión de las cintas) coinciden
+ * exactamente con los del intérprete paso a paso.
+ *
+ * La caché solo depende de la máquina y del tamaño de bloque, así que un mismo motor se reutiliza
+ * entre cadenas y entre llamadas a run() sin vaciarla.
+ */
+class MacroEngine {
+public:
+  static constexpr size_t kMaxBlockSize = 255;
+
+  MacroEngine(const CompiledMachine& program, size_t block_size);
+
+  bool run(std::vector<Tape>& tapes, uint32_t& state, size_t& step_count, size_t max_steps);
+
+private:
+  static constexpr size_t kMaxCacheEntries = size_t(1) << 16;
+  static constexpr size_t kMaxInnerSteps = size_t(1) << 16;
+
+  /**
+   * @brief Resultado cacheado de un macro-paso
+   */
+  struct MacroStep {
+    uint32_t state;
+    bool halted;
+    size_t steps;
+    std::string blocks;
+    std::vector<long> offsets;
+    std::vector<long> min_visited;
+    std::vector<long> max_visited;
+    std::vector<long> min_written;
+    std::vector<long> max_written;
+    std::vector<char> has_written;
+  };
+
+  /**
+   * @brief Cinta de trabajo del motor indexada por coordenada absoluta
+   */
+  struct WorkTape {
+    std::vector<char> cells;
+    long offset;
+    long head;
+    long min_visited;
+    long max_visited;
+    long min_written;
+    long max_written;
+    bool has_written;
+  };
+
+  const CompiledMachine* program_;
+  size_t block_size_;
+  size_t num_tapes_;
+  char blank_symbol_;
+  std::unordered_map<std::string, MacroStep> cache_;
+
+  MacroStep simulate(uint32_t state, const std::string& blocks, const std::vector<long>& offsets,
+                     size_t max_steps) const;
+  void apply(std::vector<WorkTape>& work, const std::vector<long>& block_starts, const MacroStep& step) const;
+  size_t repeatSweep(std::vector<WorkTape>& work, const std::vector<long>& block_starts, const std::string& blocks,
+                     const std::vector<long>& offsets, const MacroStep& step, size_t max_repeats) const;
+
+  long blockStart(long position) const;
+  void ensure(WorkTape& tape, long first, long last) const;
+  char* cell(WorkTape& tape, long position) const;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Fichero de cadenas de entrada proyectado en memoria.
+ *
+ * Proyecta el fichero con mmap y entrega cada línea como un std::string_view sobre la
+ * proyección, sin copiar su contenido. Las líneas siguen las mismas reglas que
+ * FileParser::parseInputStrings: cada línea es una cadena de entrada (una línea vacía es la
+ * cadena vacía) y un salto de línea final no añade una cadena más. Si el fichero no se puede
+ * proyectar (por ejemplo, un FIFO), se lee completo en memoria y se trabaja igual sobre esa copia.
+ *
+ * split() divide el fichero en rangos de bytes que empiezan y terminan en un límite de línea,
+ * de modo que varios consumidores pueden recorrerlo en paralelo con LineReader.
+ */
+class MappedInput {
+public:
+  explicit MappedInput(const std::string& filename);
+  ~MappedInput();
+
+  MappedInput(const MappedInput&) = delete;
+  MappedInput& operator=(const MappedInput&) = delete;
+
+  std::string_view getData() const;
+  std::vector<std::string_view> split(size_t num_chunks) const;
+
+private:
+  const char* data_;
+  size_t size_;
+  bool mapped_;
+  std::string buffer_;
+};
+
+/**
+ * @brief Recorre las líneas de un rango de una entrada proyectada
+ */
+class LineReader {
+public:
+  explicit LineReader(std::string_view range) : range_(range), position_(0) {}
+
+  bool next(std::string_view& line);
+
+private:
+  std::string_view range_;
+  size_t position_;
+};
+
+/**
+ * @brief Obtiene la siguiente línea del rango
+ * @param line Línea leída (sin el salto de línea)
+ * @return false si no quedan líneas
+ */
+inline bool LineReader::next(std::string_view& line) {
+  if (position_ >= range_.size()) {
+    return false;
+  }
+  size_t end = range_.find('\n', position_);
+  if (end == std::string_view::npos) {
+    end = range_.size();
+  }
+  line = range_.substr(position_, end - position_);
+  position_ = end + 1;
+  return true;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "CompiledMachine.hpp"
+#include "ThreadPool.hpp"
+
+enum class RunStatus;
+
+/**
+ * @brief Modo de ejecución de la máquina
+ */
+enum class SearchMode {
+  DETERMINISTIC,         // Aplica siempre la primera transición definida (ejecutor normal)
+  BREADTH_FIRST,         // Explora el árbol de configuraciones por niveles
+  ITERATIVE_DEEPENING    // Búsqueda en profundidad con un límite que se duplica en cada ronda
+};
+
+/**
+ * @brief Configuración resultante de una búsqueda no determinista
+ */
+struct SearchResult {
+  RunStatus status;
+  uint32_t state = 0;
+  size_t steps = 0;
+  size_t cycle_period = 0;
+  std::vector<std::string> tapes;     // Contenido de cada cinta (como Tape::getContent())
+  std::vector<int> heads;             // Posición del cabezal dentro de cada contenido
+  size_t configurations = 0;          // Configuraciones distintas exploradas
+};
+
+/**
+ * @brief Exploración del árbol de configuraciones de una máquina no determinista.
+ *
+ * Desde cada configuración se aplican todas las transiciones de su estado y sus símbolos leídos
+ * (CompiledMachine::getAlternative). Una rama acepta cuando se detiene (no le queda transición)
+ * en un estado final, y la búsqueda termina en cuanto alguna acepta. Si no acepta ninguna, la
+ * máquina rechaza cuando se han recorrido todas las configuraciones alcanzables, o se informa del
+ * límite de pasos (profundidad) o de memoria.
+ *
+ * - Las ramas comparten las celdas de las cintas con copia en escritura: una cinta solo se copia
+ *   cuando una rama escribe en ella un símbolo distinto; moverse o extender la cinta no copia.
+ * - Las configuraciones repetidas se descartan. Cada una se identifica por un hash de 128 bits
+ *   (estado, posición absoluta de cada cabezal y celdas no blancas) que se actualiza de forma
+ *   incremental en cada paso, como en CycleDetector.
+ * - En anchura, cada nivel se expande en bloques repartidos en un pool con robo de trabajo y se
+ *   deduplica por fragmentos de la tabla de configuraciones, también en paralelo. El orden de la
+ *   frontera y la rama aceptada (la primera del nivel) no dependen del número de hilos.
+ * - En profundidad iterativa, cada ronda reparte los subárboles de un primer nivel entre los
+ *   hilos; la memoria es la de las pilas y las tablas de configuraciones de cada subárbol.
+ * - La memoria estimada de la frontera y de las tablas de configuraciones no puede superar el
+ *   límite indicado.
+ *
+ * Una máquina determinista explorada así da el mismo resultado que el ejecutor paso a paso, salvo
+ * que repita una configuración sin detenerse: la búsqueda lo detecta e informa NON_HALTING.
+ */
+class NondeterministicSearch {
+public:
+  static constexpr size_t kDefaultMemoryLimit = size_t(1) << 30;
+
+  NondeterministicSearch(SearchMode mode, size_t jobs, size_t memory_limit);
+
+  SearchResult run(const CompiledMachine& program, std::string_view input, size_t max_steps);
+
+  SearchMode getMode() const;
+
+private:
+  /**
+   * @brief Cinta de una rama: celdas compartidas y extensión propia en coordenadas absolutas
+   *
+   * Las celdas fuera de [base, base + cells->size()) son blancos.
+   */
+  struct TapeView {
+    std::shared_ptr<const std::string> cells;
+    long base;
+    long begin;
+    long end;
+    long head;
+  };
+
+  /**
+   * @brief Hash de 128 bits de una configuración
+   */
+  struct Key {
+    uint64_t low;
+    uint64_t high;
+    bool operator==(const Key& other) const { return low == other.low && high == other.high; }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return static_cast<size_t>(key.high); }
+  };
+
+  /**
+   * @brief Configuración de una rama
+   */
+  struct Node {
+    uint32_t state = 0;
+    size_t depth = 0;
+    Key key{0, 0};
+    std::vector<TapeView> tapes;
+  };
+
+  /**
+   * @brief Tabla de configuraciones vistas (profundidad de la primera aparición)
+   */
+  using Visited = std::unordered_map<Key, size_t, KeyHash>;
+
+  static constexpr size_t kVisitedEntryBytes = 48;
+  static constexpr size_t kCellsBytes = 64;   // Bloque de control, string y cabecera de malloc
+
+  SearchMode mode_;
+  size_t jobs_;
+  size_t memory_limit_;
+  std::unique_ptr<ThreadPool> pool_;
+  const CompiledMachine* program_;
+  char blank_symbol_;
+  size_t num_tapes_;
+
+  SearchResult breadthFirst(Node root, size_t max_steps);
+  SearchResult iterativeDeepening(Node root, size_t max_steps);
+
+  Node makeRoot(std::string_view input) const;
+  void expand(const Node& node, std::vector<Node>& children) const;
+  size_t nodeBytes(const Node& node) const;
+  SearchResult makeResult(RunStatus status, const Node& node, size_t steps) const;
+
+  static char read(const TapeView& tape, char blank_symbol);
+  static uint64_t mix(uint64_t value);
+  static Key cellKey(size_t tape, long position, char symbol);
+  static Key headKey(size_t tape, long position);
+  static Key stateKey(uint32_t state);
+  static void toggle(Key& key, const Key& term);
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Alphabet.hpp"
+#include "TapeBackend.hpp"
+
+/**
+ * @brief Cinta empaquetada a nivel de bit.
+ *
+ * Cada símbolo de Γ se codifica con el menor ancho de celda que lo admite (1 bit si |Γ| <= 2,
+ * 2 bits si |Γ| <= 4, 4 bits si |Γ| <= 16 y 8 bits en otro caso) y las celdas se guardan en
+ * palabras de 64 bits. El blanco es siempre el código 0, de modo que las palabras a cero son
+ * celdas en blanco: ampliar la cinta, reiniciarla y quitar los blancos de los extremos se hace
+ * palabra a palabra, y los barridos comparan todas las celdas de una palabra a la vez.
+ *
+ * La organización es la de la cinta contigua (rango [begin_, end_) dentro de un buffer que
+ * duplica su capacidad hacia el extremo que se alcanza), con 2-8 veces menos memoria.
+ */
+class PackedTape : public TapeBackend {
+public:
+  PackedTape(char blank_symbol, const Alphabet& tape_alphabet);
+
+  std::unique_ptr<TapeBackend> clone() const override;
+  TapeStorage getStorage() const override;
+
+  char read() const override;
+  void write(char symbol) override;
+  void moveLeft() override;
+  void moveRight() override;
+  size_t scanLeft(const SymbolSet& symbols, size_t limit) override;
+  size_t scanRight(const SymbolSet& symbols, size_t limit) override;
+
+  int getHeadPosition() const override;
+  size_t getSize() const override;
+  std::string getContent() const override;
+  std::string getContentWithHead() const override;
+  std::string getTrimmedContent() const override;
+  std::string getRange(size_t first, size_t last) const override;
+  void reset(std::string_view input) override;
+  void load(const std::string& content, int head_position) override;
+
+  unsigned getBitsPerCell() const;
+
+private:
+  static constexpr size_t kInitialWords = 2;
+  static constexpr uint8_t kNoCode = 0xFF;
+
+  std::vector<uint64_t> words_;
+  char blank_symbol_;
+  unsigned bits_;           // Ancho de celda (1, 2, 4 u 8)
+  unsigned cell_shift_;     // log2 de las celdas por palabra
+  uint64_t cell_mask_;      // (1 << bits_) - 1
+  uint64_t low_bits_;       // Bit menos significativo de cada celda de una palabra
+  uint8_t code_of_[256];
+  char symbol_of_[256];
+  size_t begin_;
+  size_t end_;
+  size_t head_;
+  size_t origin_;
+
+  size_t capacity() const { return words_.size() << cell_shift_; }
+  uint8_t getCode(size_t cell) const;
+  void setCode(size_t cell, uint8_t code);
+  uint8_t encode(char symbol) const;
+  uint64_t matchMask(uint64_t word, const uint64_t* patterns, size_t count) const;
+  size_t buildPatterns(const SymbolSet& symbols, uint64_t* patterns) const;
+  size_t spanForward(size_t cell, size_t count, const uint64_t* patterns, size_t count_patterns) const;
+  size_t spanBackward(size_t cell, size_t count, const uint64_t* patterns, size_t count_patterns) const;
+  std::string decode(size_t from, size_t to) const;
+  void clear(size_t from, size_t to);
+  void expandLeft();
+  void expandRight();
+  void growLeft();
+  void growRight();
+};
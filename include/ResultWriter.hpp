@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "TuringMachine.hpp"
+
+/**
+ * @brief Resultado de ejecutar la máquina sobre una cadena de entrada
+ */
+struct RunResult {
+  RunStatus status = RunStatus::STEP_LIMIT;
+  size_t cycle_period = 0;
+  bool accepted = false;
+  std::string final_state;
+  size_t steps = 0;
+  std::string result;                 // Primera cinta sin blancos en los extremos
+  std::vector<std::string> tapes;     // Cintas completas con el cabezal marcado
+  std::string error;
+};
+
+/**
+ * @brief Formatos de salida de los resultados
+ */
+enum class OutputFormat {
+  TEXT,    // Texto decorado (una sección por cadena)
+  JSONL,   // Un objeto JSON por línea
+  CSV,     // Valores separados por comas con cabecera (RFC 4180)
+  TSV      // Valores separados por tabuladores con cabecera
+};
+
+/**
+ * @brief Escritor de resultados con buffer propio.
+ *
+ * Da formato a cada resultado directamente sobre un buffer grande que se vuelca a la salida
+ * estándar con una sola escritura cada kBufferSize bytes, en lugar de pasar por std::cout línea
+ * a línea. Los formatos JSONL, CSV y TSV escriben solo los campos elegidos (ver Field); si no se
+ * piden las cintas ni el resultado, tampoco hace falta obtenerlos de la máquina (wantsTapes,
+ * wantsResult). El formato TEXT reproduce la salida decorada de siempre con todos los campos.
+ */
+class ResultWriter {
+public:
+  /**
+   * @brief Campos de los formatos JSONL, CSV y TSV
+   */
+  enum Field : unsigned {
+    INDEX = 1 << 0,      // Número de la cadena (desde 1)
+    INPUT = 1 << 1,      // Cadena de entrada
+    STATUS = 1 << 2,     // halted, step_limit, non_halting o memory_limit
+    ACCEPTED = 1 << 3,   // Veredicto
+    STEPS = 1 << 4,      // Pasos ejecutados
+    STATE = 1 << 5,      // Estado final
+    RESULT = 1 << 6,     // Primera cinta sin blancos en los extremos
+    TAPES = 1 << 7       // Cintas completas con el cabezal marcado
+  };
+  static constexpr unsigned kAllFields = (1 << 8) - 1;
+
+  ResultWriter(OutputFormat format, unsigned fields, size_t num_tapes);
+  ~ResultWriter();
+  ResultWriter(const ResultWriter&) = delete;
+  ResultWriter& operator=(const ResultWriter&) = delete;
+
+  static bool parseFields(const std::string& list, unsigned& fields);
+
+  bool write(size_t index, std::string_view input, const RunResult& result);
+  void flush();
+
+  bool wantsTapes() const;
+  bool wantsResult() const;
+
+private:
+  static constexpr size_t kBufferSize = 1 << 20;
+
+  OutputFormat format_;
+  unsigned fields_;
+  size_t num_tapes_;
+  std::string buffer_;
+
+  void writeText(size_t index, std::string_view input, const RunResult& result);
+  void writeJson(size_t index, std::string_view input, const RunResult& result);
+  void writeDelimited(size_t index, std::string_view input, const RunResult& result, char separator);
+  void writeHeader(char separator);
+  void appendJsonString(std::string_view text);
+  void appendField(std::string_view text, char separator);
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "TapeBackend.hpp"
+
+/**
+ * @brief Cinta codificada por longitud de racha (run-length).
+ *
+ * La cinta se guarda como una secuencia de segmentos (símbolo, longitud) y el cabezal se
+ * localiza por el segmento en el que está y su desplazamiento dentro de él. La memoria usada
+ * depende del número de rachas y no de la longitud de la cinta, lo que la hace adecuada para
+ * máquinas que escriben rachas muy largas de un mismo símbolo (por ejemplo, contadores unarios).
+ */
+class RunLengthTape : public TapeBackend {
+public:
+  explicit RunLengthTape(char blank_symbol);
+
+  std::unique_ptr<TapeBackend> clone() const override;
+  TapeStorage getStorage() const override;
+
+  char read() const override;
+  void write(char symbol) override;
+  void moveLeft() override;
+  void moveRight() override;
+  size_t scanLeft(const SymbolSet& symbols, size_t limit) override;
+  size_t scanRight(const SymbolSet& symbols, size_t limit) override;
+
+  int getHeadPosition() const override;
+  size_t getSize() const override;
+  std::string getContent() const override;
+  std::string getContentWithHead() const override;
+  std::string getTrimmedContent() const override;
+  std::string getRange(size_t first, size_t last) const override;
+  void reset(std::string_view input) override;
+  void load(const std::string& content, int head_position) override;
+
+  size_t getRunCount() const;
+
+private:
+  /**
+   * @brief Segmento de celdas consecutivas con el mismo símbolo
+   */
+  struct Run {
+    char symbol;
+    uint64_t length;
+  };
+
+  std::vector<Run> runs_;
+  char blank_symbol_;
+  size_t run_;
+  uint64_t offset_;
+  uint64_t position_;
+  uint64_t size_;
+
+  void expandLeft();
+  void expandRight();
+  void append(char symbol, uint64_t length);
+  void mergeWithNext(size_t index);
+};
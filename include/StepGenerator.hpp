@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include "TuringMachine.hpp"
+
+/**
+ * @brief Generador que ejecuta una máquina por tramos de k pasos.
+ *
+ * Cada llamada a next() avanza la ejecución k pasos con TuringMachine::advance() (o menos, si
+ * la máquina termina o se alcanza el límite total) y entrega el resultado del tramo; entre dos
+ * llamadas la configuración se puede consultar en la máquina. Así un planificador o una interfaz
+ * intercalan muchas ejecuciones (una máquina por generador; las copias comparten el programa
+ * compilado) sin repetir pasos:
+ *
+ *   StepGenerator generator(tm, input, 1000);
+ *   StepStatus status;
+ *   while (generator.next(status)) {
+ *     mostrar(tm.getTapesContentWithHead());
+ *   }
+ */
+class StepGenerator {
+public:
+  StepGenerator(TuringMachine& machine, std::string_view input, size_t chunk,
+                size_t max_steps = std::numeric_limits<size_t>::max());
+
+  bool next(StepStatus& status);
+  bool isDone() const { return done_; }
+
+private:
+  TuringMachine& machine_;
+  size_t chunk_;
+  size_t max_steps_;
+  bool done_;
+};
+
+/**
+ * @brief Carga la cadena en la máquina
+ * @param machine Máquina que ejecuta la cadena (no debe usarse para otra mientras dure el generador)
+ * @param input Cadena de entrada
+ * @param chunk Pasos por tramo (k)
+ * @param max_steps Número máximo de pasos de toda la ejecución
+ * @throws std::invalid_argument si chunk es 0 o la cadena no pertenece a Σ*
+ */
+inline StepGenerator::StepGenerator(TuringMachine& machine, std::string_view input, size_t chunk, size_t max_steps)
+  : machine_(machine), chunk_(chunk), max_steps_(max_steps), done_(false) {
+  if (chunk_ == 0) {
+    throw std::invalid_argument("El tramo debe tener al menos un paso");
+  }
+  machine_.load(input);
+}
+
+/**
+ * @brief Avanza el siguiente tramo
+ * @param status Resultado del tramo (BUDGET_EXHAUSTED si la ejecución sigue o alcanzó max_steps)
+ * @return false si la ejecución ya había terminado antes de esta llamada
+ */
+inline bool StepGenerator::next(StepStatus& status) {
+  if (done_) {
+    return false;
+  }
+  size_t steps = machine_.getStepCount();
+  status = machine_.advance(std::min(chunk_, max_steps_ - std::min(steps, max_steps_)));
+  done_ = status != StepStatus::BUDGET_EXHAUSTED || machine_.getStepCount() >= max_steps_;
+  return true;
+}
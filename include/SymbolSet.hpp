@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Conjunto de símbolos con búsqueda vectorizada de la primera celda fuera del conjunto.
+ *
+ * Guarda los símbolos en un mapa de bits de 256 posiciones. Los conjuntos de hasta
+ * kMaxVectorSymbols símbolos se recorren además con SSE2 (16 celdas por comparación) cuando el
+ * compilador lo admite; el resto usa el mapa de bits celda a celda.
+ */
+class SymbolSet {
+public:
+  static constexpr size_t kMaxVectorSymbols = 4;
+
+  SymbolSet() : bits_{0, 0, 0, 0}, symbols_{0, 0, 0, 0}, size_(0) {}
+
+  void insert(char symbol) {
+    if (contains(symbol)) {
+      return;
+    }
+    unsigned char code = static_cast<unsigned char>(symbol);
+    bits_[code >> 6] |= uint64_t(1) << (code & 63);
+    if (size_ < kMaxVectorSymbols) {
+      symbols_[size_] = symbol;
+    }
+    size_++;
+  }
+
+  bool contains(char symbol) const {
+    unsigned char code = static_cast<unsigned char>(symbol);
+    return (bits_[code >> 6] >> (code & 63)) & 1;
+  }
+
+  size_t size() const { return size_; }
+
+  size_t spanForward(const char* cells, size_t count) const;
+  size_t spanBackward(const char* cells, size_t count) const;
+
+private:
+  uint64_t bits_[4];
+  char symbols_[kMaxVectorSymbols];
+  size_t size_;
+
+#if defined(__SSE2__)
+  unsigned matchMask(const char* cells) const;
+#endif
+};
+
+#if defined(__SSE2__)
+/**
+ * @brief Compara 16 celdas con los símbolos del conjunto
+ * @param cells Primera de las 16 celdas
+ * @return Máscara con un bit a 1 por cada celda que pertenece al conjunto
+ */
+inline unsigned SymbolSet::matchMask(const char* cells) const {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells));
+  __m128i match = _mm_cmpeq_epi8(block, _mm_set1_epi8(symbols_[0]));
+  for (size_t i = 1; i < size_; ++i) {
+    match = _mm_or_si128(match, _mm_cmpeq_epi8(block, _mm_set1_epi8(symbols_[i])));
+  }
+  return static_cast<unsigned>(_mm_movemask_epi8(match));
+}
+#endif
+
+/**
+ * @brief Cuenta las celdas consecutivas del conjunto hacia la derecha
+ * @param cells Primera celda
+ * @param count Número máximo de celdas a examinar (cells[0] .. cells[count - 1])
+ * @return Número de celdas iniciales que pertenecen al conjunto
+ */
+inline size_t SymbolSet::spanForward(const char* cells, size_t count) const {
+  size_t i = 0;
+#if defined(__SSE2__)
+  if (size_ > 0 && size_ <= kMaxVectorSymbols) {
+    for (; i + 16 <= count; i += 16) {
+      unsigned outside = ~matchMask(cells + i) & 0xFFFF;
+      if (outside != 0) {
+        return i + static_cast<size_t>(__builtin_ctz(outside));
+      }
+    }
+  }
+#endif
+  while (i < count && contains(cells[i])) {
+    i++;
+  }
+  return i;
+}
+
+/**
+ * @brief Cuenta las celdas consecutivas del conjunto hacia la izquierda
+ * @param cells Primera celda
+ * @param count Número máximo de celdas a examinar (cells[0] .. cells[1 - count])
+ * @return Número de celdas iniciales que pertenecen al conjunto
+ */
+inline size_t SymbolSet::spanBackward(const char* cells, size_t count) const {
+  size_t i = 0;
+#if defined(__SSE2__)
+  if (size_ > 0 && size_ <= kMaxVectorSymbols) {
+    for (; i + 16 <= count; i += 16) {
+      unsigned outside = ~matchMask(cells - i - 15) & 0xFFFF;
+      if (outside != 0) {
+        return i + 15 - static_cast<size_t>(31 - __builtin_clz(outside));
+      }
+    }
+  }
+#endif
+  while (i < count && contains(*(cells - i))) {
+    i++;
+  }
+  return i;
+}
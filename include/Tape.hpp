@@ -1,36 +1,139 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <deque>
+#include "Alphabet.hpp"
+#include "TapeBackend.hpp"
 
 /**
  * @brief Representa la cinta de una máquina de Turing con capacidad de expansión infinita.
  * 
  * La cinta permite lectura, escritura y movimiento del cabezal en ambas direcciones.
  * Se expande automáticamente cuando es necesario usando un símbolo en blanco configurable.
+ *
+ * Las celdas se guardan en un único buffer contiguo: la cinta lógica es el rango [begin_, end_)
+ * y el resto del buffer se mantiene relleno de blancos. Cuando la cinta alcanza un extremo del
+ * buffer, este duplica su capacidad hacia ese lado. reset() reutiliza el buffer, de modo que
+ * ejecutar un lote de entradas no reserva memoria una vez que la cinta ha alcanzado su tamaño máximo.
+ *
+ * Con setStorage() la cinta puede usar otro almacenamiento (TapeBackend), al que se delegan
+ * todas las operaciones; el contenido y la posición del cabezal se conservan al cambiarlo.
+ *
+ * La cinta lleva además la cota del tramo escrito [written_begin_, written_end_): contiene la
+ * entrada y todas las celdas en las que se ha escrito un símbolo no blanco, así que fuera de ella
+ * solo hay blancos. Las vistas (getView, getNonBlankView, getWindow) apuntan directamente al
+ * buffer, sin copiar, y el tramo no blanco se obtiene recortando la cota en lugar de recorrer la
+ * cinta entera. Una vista es válida hasta la siguiente operación que modifique la cinta; con otro
+ * almacenamiento se construye en un buffer de la propia cinta.
  */
 class Tape {
 public:
   Tape(char blank_symbol = '.');
   Tape(const std::string& input, char blank_symbol = '.');
+  Tape(const Tape& other);
+  Tape(Tape&& other) = default;
+  Tape& operator=(const Tape& other);
+  Tape& operator=(Tape&& other) = default;
   
-  char read() const;
+  void setStorage(TapeStorage storage, const Alphabet& symbols = Alphabet());
+  TapeStorage getStorage() const;
+  
+  // Operaciones del bucle de ejecución, definidas en la cabecera para que puedan expandirse en línea
+  char read() const { return backend_ ? backend_->read() : buffer_[head_]; }
   void write(char symbol);
   void moveLeft();
   void moveRight();
-  void moveStay();
+  void moveStay() {}
+  size_t scanLeft(const SymbolSet& symbols, size_t limit);
+  size_t scanRight(const SymbolSet& symbols, size_t limit);
   
   int getHeadPosition() const;
+  size_t getSize() const;
   std::string getContent() const;
   std::string getContentWithHead() const;
-  void reset(const std::string& input);
+  std::string getTrimmedContent() const;
+  std::string_view getView() const;
+  std::string_view getNonBlankView() const;
+  std::string_view getNonBlankView(size_t& first) const;
+  std::string_view getWindow(size_t radius, size_t& head_offset) const;
+  void reset(std::string_view input);
+  void load(const std::string& content, int head_position);
   
 private:
-  std::deque<char> tape_;
+  static constexpr size_t kInitialCapacity = 64;
+
+  std::vector<char> buffer_;
   char blank_symbol_;
-  int head_position_;
+  size_t begin_;
+  size_t end_;
+  size_t head_;
+  size_t origin_;
+  size_t written_begin_;
+  size_t written_end_;
+  std::unique_ptr<TapeBackend> backend_;
+  mutable std::string materialized_;    // Vistas de los almacenamientos alternativos
   
   void expandLeft();
   void expandRight();
+  void extendWritten();
+  void growLeft();
+  void growRight();
 };
+
+/**
+ * @brief Escribe un símbolo en la posición actual del cabezal
+ * @param symbol Símbolo a escribir
+ *
+ * Escribir un símbolo no blanco en un extremo de la cinta la expande por ese lado.
+ */
+inline void Tape::write(char symbol) {
+  if (backend_) {
+    backend_->write(symbol);
+    return;
+  }
+  
+  buffer_[head_] = symbol;
+  
+  if (symbol != blank_symbol_) {
+    if (head_ - written_begin_ >= written_end_ - written_begin_) {
+      extendWritten();
+    }
+    if (head_ == begin_) {
+      expandLeft();
+    }
+    if (head_ == end_ - 1) {
+      expandRight();
+    }
+  }
+}
+
+/**
+ * @brief Mueve el cabezal a la izquierda (L), expandiendo la cinta si es necesario
+ */
+inline void Tape::moveLeft() {
+  if (backend_) {
+    backend_->moveLeft();
+    return;
+  }
+  if (head_ == begin_) {
+    expandLeft();
+  }
+  head_--;
+}
+
+/**
+ * @brief Mueve el cabezal a la derecha (R), expandiendo la cinta si es necesario
+ */
+inline void Tape::moveRight() {
+  if (backend_) {
+    backend_->moveRight();
+    return;
+  }
+  if (head_ == end_ - 1) {
+    expandRight();
+  }
+  head_++;
+}
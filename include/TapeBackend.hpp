@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include "SymbolSet.hpp"
+
+/**
+ * @brief Almacenamiento disponible para las cintas
+ */
+enum class TapeStorage {
+  CONTIGUOUS,
+  RUN_LENGTH,
+  PACKED
+};
+
+/**
+ * @brief Interfaz de los almacenamientos alternativos de una cinta.
+ *
+ * Tape implementa directamente el almacenamiento contiguo (el más rápido); el resto de
+ * representaciones implementan esta interfaz y Tape les delega las operaciones. Todas deben
+ * reproducir exactamente la semántica de la cinta contigua, incluida su extensión: la cinta
+ * crece una celda al mover el cabezal más allá de un extremo o al escribir un símbolo no
+ * blanco en un extremo.
+ */
+class TapeBackend {
+public:
+  virtual ~TapeBackend() = default;
+
+  virtual std::unique_ptr<TapeBackend> clone() const = 0;
+  virtual TapeStorage getStorage() const = 0;
+
+  virtual char read() const = 0;
+  virtual void write(char symbol) = 0;
+  virtual void moveLeft() = 0;
+  virtual void moveRight() = 0;
+  virtual size_t scanLeft(const SymbolSet& symbols, size_t limit) = 0;
+  virtual size_t scanRight(const SymbolSet& symbols, size_t limit) = 0;
+
+  virtual int getHeadPosition() const = 0;
+  virtual size_t getSize() const = 0;
+  virtual std::string getContent() const = 0;
+  virtual std::string getContentWithHead() const = 0;
+  virtual std::string getTrimmedContent() const = 0;
+  virtual std::string getRange(size_t first, size_t last) const = 0;
+  virtual void reset(std::string_view input) = 0;
+  virtual void load(const std::string& content, int head_position) = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool de hilos con robo de trabajo (work stealing).
+ *
+ * Cada hilo tiene su propia cola de tareas: toma trabajo del final de la suya (LIFO) y, cuando
+ * se queda sin trabajo, roba del principio de las colas de los demás (FIFO). Las tareas enviadas
+ * desde un hilo del pool van a la cola de ese hilo, de modo que una tarea puede dividirse en
+ * subtareas que otros hilos ociosos roban. Cada tarea recibe el índice del hilo que la ejecuta,
+ * lo que permite mantener un contexto de ejecución por hilo.
+ */
+class ThreadPool {
+public:
+  using Task = std::function<void(size_t)>;
+
+  explicit ThreadPool(size_t num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void submit(Task task);
+  void wait();
+  size_t size() const;
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable all_done_;
+  std::atomic<size_t> queued_;
+  std::atomic<size_t> pending_;
+  std::atomic<size_t> next_queue_;
+  bool stopping_;
+
+  void workerLoop(size_t index);
+  bool tryPop(size_t index, Task& task);
+};
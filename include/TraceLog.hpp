@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CompiledMachine.hpp"
+
+enum class RunStatus;
+
+/**
+ * @brief Registro binario de la traza de ejecución.
+ *
+ * El fichero empieza con una cabecera ("MTTR", versión, número de cintas, símbolo blanco y los
+ * estados con su nombre y si son finales) seguida de registros codificados con varints:
+ *
+ * - Inicio de ejecución: estado inicial y cadena de entrada.
+ * - Paso: diferencia con el índice de la transición anterior (en zigzag), estado siguiente, una
+ *   máscara con las cintas cuya celda cambia seguida solo de esos símbolos, y los movimientos
+ *   empaquetados a 2 bits por cinta.
+ * - Fin de ejecución: pasos, cómo terminó y estado final.
+ *
+ * El primer varint de cada registro distingue los pasos (bit 0 a 0) de los registros de control
+ * (bit 0 a 1), de modo que un paso de una máquina de una cinta ocupa normalmente 4 bytes. Con
+ * la cadena de entrada y los cambios de cada paso, TraceReader reconstruye todas las
+ * configuraciones sin necesitar la definición de la máquina.
+ */
+class TraceWriter {
+public:
+  TraceWriter(const std::string& path, const CompiledMachine& program);
+  ~TraceWriter();
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  void beginRun(std::string_view input, uint32_t state);
+  void step(const CompiledMachine& program, int32_t transition, const char* read_symbols);
+  void endRun(size_t steps, RunStatus status, uint32_t state);
+  void flush();
+
+private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  std::FILE* file_;
+  std::string path_;
+  std::vector<uint8_t> buffer_;
+  size_t used_;
+  size_t num_tapes_;
+  int32_t last_transition_;
+
+  void reserve(size_t size);
+  void putByte(uint8_t byte);
+  void putVarint(uint64_t value);
+};
+
+/**
+ * @brief Política de traza del bucle de ejecución que no hace nada (ejecución sin traza)
+ */
+class NullTracer {
+public:
+  static constexpr bool kEnabled = false;
+
+  explicit NullTracer(TraceWriter*) {}
+  void step(const CompiledMachine&, int32_t, const char*) {}
+};
+
+/**
+ * @brief Política de traza del bucle de ejecución que escribe cada paso en un TraceWriter
+ */
+class BinaryTracer {
+public:
+  static constexpr bool kEnabled = true;
+
+  explicit BinaryTracer(TraceWriter* writer) : writer_(writer) {}
+  void step(const CompiledMachine& program, int32_t transition, const char* read_symbols) {
+    writer_->step(program, transition, read_symbols);
+  }
+
+private:
+  TraceWriter* writer_;
+};
+
+/**
+ * @brief Registro leído de una traza binaria
+ */
+struct TraceEvent {
+  enum class Kind {
+    RUN_BEGIN,
+    STEP,
+    RUN_END
+  };
+
+  Kind kind = Kind::STEP;
+  uint32_t state = 0;              // Estado inicial, siguiente o final según el registro
+  std::string input;               // RUN_BEGIN: cadena de entrada
+  int32_t transition = 0;          // STEP: índice de la transición aplicada
+  std::vector<char> changed;       // STEP: 1 si la celda de la cinta cambia
+  std::vector<char> writes;        // STEP: símbolo escrito en las cintas que cambian
+  std::vector<Movement> moves;     // STEP: movimiento de cada cabezal
+  size_t steps = 0;                // RUN_END: pasos de la ejecución
+  RunStatus status{};              // RUN_END: cómo terminó la ejecución
+};
+
+/**
+ * @brief Lector secuencial de una traza binaria escrita por TraceWriter
+ */
+class TraceReader {
+public:
+  explicit TraceReader(const std::string& path);
+
+  bool next(TraceEvent& event);
+
+  size_t getNumTapes() const;
+  char getBlankSymbol() const;
+  const std::string& getStateName(uint32_t state) const;
+  bool isFinal(uint32_t state) const;
+
+private:
+  std::string data_;
+  size_t position_;
+  std::string path_;
+  size_t num_tapes_;
+  char blank_symbol_;
+  std::vector<std::string> state_names_;
+  std::vector<char> final_;
+  int32_t last_transition_;
+
+  uint8_t getByte();
+  uint64_t getVarint();
+  uint32_t getState();
+};
+
+/**
+ * @brief Escribe un paso
+ * @param program Máquina compilada (escrituras y movimientos de la transición)
+ * @param transition Índice de la transición aplicada
+ * @param read_symbols Símbolos leídos antes de aplicarla
+ */
+inline void TraceWriter::step(const CompiledMachine& program, int32_t transition, const char* read_symbols) {
+  reserve(2 * 10 + 2 * num_tapes_ + 8);
+  int64_t delta = static_cast<int64_t>(transition) - last_transition_;
+  last_transition_ = transition;
+  putVarint(((static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63)) << 1);
+  putVarint(program.getNextState(transition));
+
+  size_t mask_at = used_;
+  size_t mask_bytes = (num_tapes_ + 7) / 8;
+  for (size_t i = 0; i < mask_bytes; ++i) {
+    putByte(0);
+  }
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    char symbol = program.getWriteSymbol(transition, i, read_symbols[i]);
+    if (symbol != read_symbols[i]) {
+      buffer_[mask_at + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+      putByte(static_cast<uint8_t>(symbol));
+    }
+  }
+
+  uint8_t moves = 0;
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    moves |= static_cast<uint8_t>(static_cast<uint8_t>(program.getMovement(transition, i)) << (2 * (i % 4)));
+    if (i % 4 == 3 || i + 1 == num_tapes_) {
+      putByte(moves);
+      moves = 0;
+    }
+  }
+}
+
+/**
+ * @brief Reserva espacio en el buffer, volcándolo al fichero si no cabe
+ */
+inline void TraceWriter::reserve(size_t size) {
+  if (used_ + size > buffer_.size()) {
+    flush();
+    if (size > buffer_.size()) {
+      buffer_.resize(size);
+    }
+  }
+}
+
+inline void TraceWriter::putByte(uint8_t byte) {
+  buffer_[used_++] = byte;
+}
+
+inline void TraceWriter::putVarint(uint64_t value) {
+  while (value >= 0x80) {
+    buffer_[used_++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  buffer_[used_++] = static_cast<uint8_t>(value);
+}
@@ -15,9 +15,14 @@ enum class Movement {
  * Para multicinta: δ(q, [s1, s2, ..., sn]) = (q', [s1', s2', ..., sn'], [m1, m2, ..., mn])
  * Movimientos: L (izquierda), R (derecha), S (sin movimiento)
  * Escritura y movimientos simultáneos
+ *
+ * Si el comodín kWildcard no pertenece a Γ, puede usarse como símbolo leído (lee cualquier
+ * símbolo) y como símbolo escrito (escribe el símbolo leído en esa cinta).
  */
 class Transition {
 public:
+  static constexpr char kWildcard = '*';
+
   Transition(const std::string& current_state,
              const std::vector<char>& read_symbols,
              const std::string& next_state,
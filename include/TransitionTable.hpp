@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Alphabet.hpp"
+#include "Transition.hpp"
+
+/**
+ * @brief Tabla de despacho de transiciones indexada por estado y símbolos leídos.
+ *
+ * Cada símbolo de Γ recibe un código en [0, |Γ|) y la tupla de símbolos leídos se empaqueta
+ * junto al índice del estado en una única clave. Si el espacio de claves es pequeño (o, hasta
+ * kMaxDenseEntries, está ocupado al menos en 1/kMaxSparsity) se usa una tabla densa (acceso
+ * directo); si no, una tabla hash sobre la clave empaquetada, o sobre los bytes de la tupla
+ * cuando la clave no cabe en 64 bits.
+ *
+ * Las claves con comodines (Transition::kWildcard en alguna cinta, si no pertenece a Γ) no se
+ * expanden a todas las combinaciones de Γ: cada patrón (conjunto de cintas con símbolo concreto)
+ * tiene su propia tabla indexada solo por esas cintas, de tamaño |Q|·|Γ|^m con m cintas concretas.
+ * Si no hay transición exacta se consultan los patrones: gana el de menos comodines y, a igualdad,
+ * la transición definida antes.
+ *
+ * La tabla densa puede residir fuera del objeto, por ejemplo en una imagen binaria proyectada
+ * en memoria; quien la proporciona debe mantenerla viva mientras se use la tabla.
+ */
+class TransitionTable {
+public:
+  static constexpr int32_t kNoTransition = -1;
+
+  TransitionTable();
+  TransitionTable(size_t num_states, const Alphabet& tape_alphabet, size_t num_tapes,
+                  const int32_t* external_dense = nullptr, size_t num_keys = SIZE_MAX);
+  TransitionTable(const TransitionTable& other);
+  TransitionTable& operator=(const TransitionTable& other);
+
+  void insert(size_t state, const std::vector<char>& symbols, int32_t index);
+  bool isDense() const;
+  size_t getDenseSize() const;
+  const int32_t* getDenseData() const;
+
+  /**
+   * @brief Busca la transición aplicable a un estado y símbolos leídos
+   * @param state Índice del estado actual
+   * @param symbols Puntero a los num_tapes símbolos leídos
+   * @return Índice de la transición en δ, o kNoTransition si no existe
+   *
+   * Definida en la cabecera para que pueda expandirse en línea en el bucle de ejecución.
+   */
+  int32_t find(size_t state, const char* symbols) const {
+    int32_t index = findExact(state, symbols);
+    if (index == kNoTransition && !patterns_.empty()) {
+      return findPattern(state, symbols);
+    }
+    return index;
+  }
+
+  size_t getNumPatterns() const;
+  size_t getNumEntries() const;
+
+private:
+  struct Pattern;
+
+  static constexpr size_t kMaxDenseEntries = size_t(1) << 20;
+  static constexpr size_t kSparseEntries = size_t(1) << 16;   // A partir de aquí se mira la ocupación
+  static constexpr size_t kMaxSparsity = 16;
+
+  size_t num_states_;
+  size_t num_tapes_;
+  uint64_t radix_;
+  std::array<int16_t, 256> codes_;
+  bool packed_;
+  bool dense_;
+
+  std::vector<int32_t> dense_table_;
+  const int32_t* dense_data_;
+  std::unordered_map<uint64_t, int32_t> packed_table_;
+  std::unordered_map<std::string, int32_t> wide_table_;
+  std::vector<Pattern> patterns_;   // Ordenados por número de comodines
+
+  TransitionTable(size_t num_states, const std::array<int16_t, 256>& codes, uint64_t radix, size_t num_tapes);
+
+  void chooseRepresentation(const int32_t* external_dense, size_t num_keys);
+  void insertPattern(size_t state, const std::vector<char>& symbols, std::vector<uint32_t> tapes, int32_t index);
+  int32_t findPattern(size_t state, const char* symbols) const;
+  int32_t findWide(size_t state, const char* symbols, const uint32_t* tapes) const;
+  std::string wideKey(size_t state, const char* symbols, const uint32_t* tapes) const;
+
+  /**
+   * @brief Busca una transición con clave exacta (sin comodines)
+   * @param state Índice del estado actual
+   * @param symbols Símbolos leídos
+   * @param tapes Cintas cuyos símbolos forman la clave (nullptr para las num_tapes primeras)
+   * @return Índice de la transición en δ, o kNoTransition si no existe
+   */
+  int32_t findExact(size_t state, const char* symbols, const uint32_t* tapes = nullptr) const {
+    if (packed_) {
+      uint64_t key;
+      if (!packKey(state, symbols, tapes, key)) {
+        return kNoTransition;
+      }
+      if (dense_) {
+        return dense_data_[key];
+      }
+      auto it = packed_table_.find(key);
+      return it == packed_table_.end() ? kNoTransition : it->second;
+    }
+    return findWide(state, symbols, tapes);
+  }
+
+  /**
+   * @brief Empaqueta estado y símbolos en una clave numérica
+   * @param state Índice del estado
+   * @param symbols Símbolos leídos
+   * @param tapes Cintas cuyos símbolos forman la clave (nullptr para las num_tapes primeras)
+   * @param key Clave resultante
+   * @return false si algún símbolo no pertenece a Γ (no puede haber transición)
+   */
+  bool packKey(size_t state, const char* symbols, const uint32_t* tapes, uint64_t& key) const {
+    key = state;
+    for (size_t i = 0; i < num_tapes_; ++i) {
+      int16_t code = codes_[static_cast<unsigned char>(symbols[tapes == nullptr ? i : tapes[i]])];
+      if (code < 0) {
+        return false;
+      }
+      key = key * radix_ + static_cast<uint64_t>(code);
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief Transiciones con comodines en las mismas cintas, indexadas por las cintas concretas
+ */
+struct TransitionTable::Pattern {
+  std::vector<uint32_t> tapes;   // Cintas con símbolo concreto, en orden
+  size_t wildcards;              // Número de cintas con comodín
+  TransitionTable table;         // Tabla de |tapes| cintas
+};
@@ -1,12 +1,43 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 #include <map>
+#include <memory>
+#include <optional>
 #include "Tape.hpp"
 #include "Transition.hpp"
 #include "Alphabet.hpp"
+#include "CompiledMachine.hpp"
+#include "ExecutionProfile.hpp"
+#include "MacroEngine.hpp"
+#include "NondeterministicSearch.hpp"
+#include "TraceLog.hpp"
+
+/**
+ * @brief Resultado de una ejecución
+ */
+enum class RunStatus {
+  HALTED,        // No hay transición aplicable
+  STEP_LIMIT,    // Se alcanzó el número máximo de pasos
+  NON_HALTING,   // Se repitió una configuración: la máquina no se detiene
+  MEMORY_LIMIT   // La búsqueda no determinista superó su límite de memoria
+};
+
+/**
+ * @brief Resultado de avanzar una ejecución con TuringMachine::advance()
+ *
+ * La máquina se detiene justo cuando no hay transición aplicable, así que HALTED y ACCEPTED son
+ * las dos formas de quedarse sin transición.
+ */
+enum class StepStatus {
+  ACCEPTED,           // Se detuvo en un estado final
+  HALTED,             // Se detuvo en un estado no final
+  BUDGET_EXHAUSTED,   // Ejecutó todos los pasos pedidos; puede seguir avanzando
+  NON_HALTING         // Se repitió una configuración (con la detección de ciclos activa)
+};
 
 /**
  * @brief Representa una máquina de Turing multiciclo que procesa símbolos mediante cintas y transiciones.
@@ -22,20 +53,45 @@ public:
                 size_t num_tapes = 1);
   
   void addTransition(const Transition& transition);
-  bool run(const std::string& input, size_t max_steps = 10000);
+  void compile();
+  void setMacroBlockSize(size_t block_size);
+  void setTapeStorage(size_t tape, TapeStorage storage);
+  void setCycleDetection(bool enabled);
+  void setProfiling(bool enabled);
+  void setTraceFile(const std::string& path);
+  void setSearchMode(SearchMode mode, size_t jobs = 1,
+                     size_t memory_limit = NondeterministicSearch::kDefaultMemoryLimit);
+  bool run(std::string_view input, size_t max_steps = 10000);
+  void load(std::string_view input);
+  StepStatus advance(size_t steps);
   
   bool isAccepted() const;
   std::string getCurrentState() const;
   std::vector<std::string> getTapesContent() const;
   std::vector<std::string> getTapesContentWithHead() const;
+  const Tape& getTape(size_t index) const;
   size_t getStepCount() const;
+  RunStatus getRunStatus() const;
+  size_t getCyclePeriod() const;
+  size_t getNumTapes() const;
+  const Alphabet& getInputAlphabet() const;
+  std::shared_ptr<const CompiledMachine> getProgram() const;
+  const ExecutionProfile* getProfile() const;
   
   void reset();
   void printConfiguration() const;
   std::string getResultFromFirstTape() const;
+  std::string_view getResultViewFromFirstTape() const;
   void printTrace(const Transition* transition = nullptr) const;
 
 private:
+  friend class MachineImage;
+  friend class Checkpoint;
+  friend class MachineOptimizer;
+
+  TuringMachine(std::shared_ptr<const CompiledMachine> program, const Alphabet& input_alphabet,
+                const Alphabet& tape_alphabet);
+
   std::set<std::string> states_;
   Alphabet input_alphabet_;
   Alphabet tape_alphabet_;
@@ -45,14 +101,38 @@ private:
   size_t num_tapes_;
   
   std::vector<Transition> transitions_;
+  bool transitions_pending_;
+  std::shared_ptr<const CompiledMachine> program_;
+  bool program_dirty_;
+  size_t macro_block_size_;
+  std::optional<MacroEngine> macro_;   // Se conserva entre ejecuciones junto con su caché de bloques
+  bool detect_cycles_;
+  std::optional<ExecutionProfile> profile_;
+  std::shared_ptr<TraceWriter> trace_;
+  bool trace_open_;    // La ejecución en curso tiene abierto su registro en la traza
+  std::shared_ptr<NondeterministicSearch> search_;
+  
   std::vector<Tape> tapes_;
-  std::string current_state_;
+  uint32_t current_state_;
   size_t step_count_;
   bool halted_;
+  RunStatus status_;
+  size_t cycle_period_;
+  
+  // Motor de ejecución especializado según el número de cintas (0 = genérico), la detección de
+  // ciclos, el perfilado y la política de traza
+  using RunLoop = void (TuringMachine::*)(size_t);
+  RunLoop run_loop_;
+  std::vector<char> symbols_;
   
-  const Transition* findTransition(const std::string& state, 
-                                   const std::vector<char>& symbols) const;
-  bool executeStep();
-  void initializeTapes(const std::string& input);
-  std::vector<char> readCurrentSymbols() const;
+  template <size_t N, bool kDetectCycles, bool kProfile, typename Tracer>
+  void runLoop(size_t max_steps);
+  template <size_t N, bool kDetectCycles, bool kProfile>
+  RunLoop selectTracer() const;
+  template <size_t N>
+  RunLoop selectRunLoopFor() const;
+  void selectRunLoop();
+  void execute(size_t max_steps);
+  void initializeTapes(std::string_view input);
+  void restoreTransitions();
 };
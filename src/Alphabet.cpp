@@ -1,19 +1,23 @@
 #include "../include/Alphabet.hpp"
+#include <climits>
 #include <sstream>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /**
  * @brief Constructor por defecto (alfabeto vacío)
  */
-Alphabet::Alphabet() : symbols_() {}
+Alphabet::Alphabet() : bits_{0, 0, 0, 0}, size_(0), range_first_{}, range_length_{}, num_ranges_(0) {}
 
 /**
  * @brief Constructor a partir de un vector de símbolos
  * @param symbols Vector de strings (cada string debe ser un símbolo de un carácter)
  */
-Alphabet::Alphabet(const std::vector<std::string>& symbols) : symbols_() {
+Alphabet::Alphabet(const std::vector<std::string>& symbols) : Alphabet() {
   for (const auto& symbol : symbols) {
     if (!symbol.empty()) {
-      symbols_.insert(symbol[0]);
+      addSymbol(symbol[0]);
     }
   }
 }
@@ -22,31 +26,108 @@ Alphabet::Alphabet(const std::vector<std::string>& symbols) : symbols_() {
  * @brief Constructor a partir de un set de caracteres
  * @param symbols Set de caracteres
  */
-Alphabet::Alphabet(const std::set<char>& symbols) : symbols_(symbols) {}
+Alphabet::Alphabet(const std::set<char>& symbols) : Alphabet() {
+  for (char symbol : symbols) {
+    addSymbol(symbol);
+  }
+}
 
 /**
  * @brief Añade un símbolo al alfabeto
  * @param symbol Símbolo a añadir
  */
 void Alphabet::addSymbol(char symbol) {
-  symbols_.insert(symbol);
+  if (contains(symbol)) {
+    return;
+  }
+  unsigned char code = static_cast<unsigned char>(symbol);
+  bits_[code >> 6] |= uint64_t(1) << (code & 63);
+  size_++;
+  findRanges();
+}
+
+/**
+ * @brief Agrupa los símbolos en rangos de códigos consecutivos
+ *
+ * Si hay más de kMaxVectorRanges rangos, num_ranges_ lo indica y containsAll() usa el mapa de bits.
+ */
+void Alphabet::findRanges() {
+  num_ranges_ = 0;
+  for (unsigned code = 0; code < 256; ++code) {
+    if (!contains(static_cast<char>(code))) {
+      continue;
+    }
+    unsigned last = code;
+    while (last + 1 < 256 && contains(static_cast<char>(last + 1))) {
+      last++;
+    }
+    if (num_ranges_ < kMaxVectorRanges) {
+      range_first_[num_ranges_] = static_cast<unsigned char>(code);
+      range_length_[num_ranges_] = static_cast<unsigned char>(last - code);
+    }
+    num_ranges_++;
+    code = last;
+  }
 }
 
 /**
- * @brief Verifica si un símbolo pertenece al alfabeto
- * @param symbol Símbolo a verificar
- * @return true si el símbolo pertenece al alfabeto, false en caso contrario
+ * @brief Verifica si todos los caracteres de una cadena pertenecen al alfabeto
+ * @param text Cadena a verificar
+ * @return true si la cadena pertenece a Σ* (la cadena vacía siempre pertenece)
+ *
+ * Con SSE2 y como mucho kMaxVectorRanges rangos, cada bloque de 16 caracteres se compara con
+ * cada rango [primero, primero + longitud] restando el primer código y comprobando sin signo que
+ * el resultado no supera la longitud. El último bloque se solapa con el anterior en lugar de
+ * recorrer el resto carácter a carácter.
  */
-bool Alphabet::contains(char symbol) const {
-  return symbols_.find(symbol) != symbols_.end();
+bool Alphabet::containsAll(std::string_view text) const {
+  size_t i = 0;
+#if defined(__SSE2__)
+  if (num_ranges_ <= kMaxVectorRanges && text.size() >= 16) {
+    __m128i firsts[kMaxVectorRanges];
+    __m128i lengths[kMaxVectorRanges];
+    for (size_t r = 0; r < num_ranges_; ++r) {
+      firsts[r] = _mm_set1_epi8(static_cast<char>(range_first_[r]));
+      lengths[r] = _mm_set1_epi8(static_cast<char>(range_length_[r]));
+    }
+    auto inside = [&](const char* cells) {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells));
+      __m128i match = _mm_setzero_si128();
+      for (size_t r = 0; r < num_ranges_; ++r) {
+        __m128i offset = _mm_sub_epi8(block, firsts[r]);
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(_mm_min_epu8(offset, lengths[r]), offset));
+      }
+      return _mm_movemask_epi8(match) == 0xFFFF;
+    };
+    for (; i + 16 <= text.size(); i += 16) {
+      if (!inside(text.data() + i)) {
+        return false;
+      }
+    }
+    return i == text.size() || inside(text.data() + text.size() - 16);
+  }
+#endif
+  for (; i < text.size(); ++i) {
+    if (!contains(text[i])) {
+      return false;
+    }
+  }
+  return true;
 }
 
 /**
- * @brief Obtiene el conjunto de símbolos
- * @return Set de caracteres del alfabeto
+ * @brief Obtiene los símbolos del alfabeto
+ * @return Símbolos en orden creciente de char
  */
-const std::set<char>& Alphabet::getSymbols() const {
-  return symbols_;
+std::string Alphabet::getSymbols() const {
+  std::string symbols;
+  symbols.reserve(size_);
+  for (int symbol = CHAR_MIN; symbol <= CHAR_MAX; ++symbol) {
+    if (contains(static_cast<char>(symbol))) {
+      symbols += static_cast<char>(symbol);
+    }
+  }
+  return symbols;
 }
 
 /**
@@ -54,7 +135,7 @@ const std::set<char>& Alphabet::getSymbols() const {
  * @return Número de símbolos
  */
 size_t Alphabet::size() const {
-  return symbols_.size();
+  return size_;
 }
 
 /**
@@ -62,7 +143,7 @@ size_t Alphabet::size() const {
  * @return true si está vacío, false en caso contrario
  */
 bool Alphabet::isEmpty() const {
-  return symbols_.empty();
+  return size_ == 0;
 }
 
 /**
@@ -73,7 +154,7 @@ std::string Alphabet::toString() const {
   std::ostringstream oss;
   oss << "{";
   bool first = true;
-  for (char symbol : symbols_) {
+  for (char symbol : getSymbols()) {
     if (!first) {
       oss << ", ";
     }
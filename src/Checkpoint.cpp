@@ -0,0 +1,161 @@
+#include "../include/Checkpoint.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Añade bytes al hash FNV-1a de 64 bits
+ */
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001B3ULL;
+  }
+}
+
+/**
+ * @brief Lee exactamente size bytes del fichero
+ */
+bool readBytes(std::ifstream& file, void* data, size_t size) {
+  file.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+  return static_cast<size_t>(file.gcount()) == size;
+}
+
+}  // namespace
+
+/**
+ * @brief Calcula la huella de una máquina (FNV-1a de Q, los estados finales, el blanco y δ)
+ * @param machine Máquina compilada
+ * @return Huella que identifica la máquina y la versión del formato
+ */
+uint64_t Checkpoint::fingerprint(const TuringMachine& machine) {
+  const CompiledMachine& program = *machine.program_;
+  uint64_t hash = 0xCBF29CE484222325ULL ^ kVersion;
+  uint64_t header[3] = {program.getNumStates(), program.getNumTapes(),
+                        static_cast<unsigned char>(program.getBlankSymbol())};
+  hashBytes(hash, header, sizeof(header));
+  for (uint32_t state = 0; state < program.getNumStates(); ++state) {
+    const std::string& name = program.getStateName(state);
+    hashBytes(hash, name.c_str(), name.size() + 1);
+    char final = program.isFinal(state) ? 1 : 0;
+    hashBytes(hash, &final, 1);
+  }
+  for (size_t i = 0; i < program.getNumTransitions(); ++i) {
+    std::string transition = program.getTransition(i).toString();
+    hashBytes(hash, transition.c_str(), transition.size() + 1);
+  }
+  return hash;
+}
+
+/**
+ * @brief Guarda la configuración actual de la máquina
+ * @param path Ruta del punto de control
+ * @param machine Máquina a mitad de una ejecución
+ * @param input_index Posición de la cadena en el fichero de entrada (desde 0)
+ * @param input Cadena de entrada de la ejecución
+ * @throws std::runtime_error si el fichero no se puede escribir
+ *
+ * Se escribe en un fichero temporal que después se renombra, de modo que una interrupción a
+ * mitad de la escritura deja intacto el punto de control anterior.
+ */
+void Checkpoint::write(const std::string& path, const TuringMachine& machine, size_t input_index,
+                       std::string_view input) {
+  if (machine.program_dirty_) {
+    throw std::logic_error("La máquina debe compilarse antes de guardar un punto de control");
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.num_tapes = static_cast<uint32_t>(machine.num_tapes_);
+  header.machine_hash = fingerprint(machine);
+  header.input_index = input_index;
+  header.input_size = input.size();
+  header.step_count = machine.step_count_;
+  header.state = machine.current_state_;
+
+  std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+  data.append(input.data(), input.size());
+  for (const auto& tape : machine.tapes_) {
+    size_t first;
+    std::string_view cells = tape.getNonBlankView(first);
+    uint64_t sizes[4] = {static_cast<uint64_t>(tape.getHeadPosition()), tape.getSize(), first, cells.size()};
+    data.append(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+    data.append(cells.data(), cells.size());
+  }
+
+  std::string temporary = path + ".tmp." + std::to_string(::getpid());
+  std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("No se pudo escribir el punto de control: " + path);
+  }
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  file.close();
+  if (!file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("No se pudo escribir el punto de control: " + path);
+  }
+}
+
+/**
+ * @brief Restaura en la máquina la configuración de un punto de control
+ * @param path Ruta del punto de control
+ * @param machine Máquina con la que se guardó (misma huella)
+ * @param input Cadena de entrada de la ejecución guardada
+ * @return Posición de la cadena en el fichero de entrada (desde 0)
+ * @throws std::runtime_error si el fichero no se puede leer, no es válido o es de otra máquina
+ *
+ * Tras restaurarlo, advance() continúa la ejecución guardada (sin traza: el registro de la
+ * ejecución quedó en el proceso que la empezó).
+ */
+size_t Checkpoint::read(const std::string& path, TuringMachine& machine, std::string& input) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("No se pudo abrir el punto de control: " + path);
+  }
+  if (machine.program_dirty_) {
+    machine.compile();
+  }
+
+  Header header;
+  if (!readBytes(file, &header, sizeof(header)) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.byte_order != kByteOrder) {
+    throw std::runtime_error("Punto de control inválido: " + path);
+  }
+  if (header.num_tapes != machine.num_tapes_ || header.machine_hash != fingerprint(machine) ||
+      header.state >= machine.program_->getNumStates()) {
+    throw std::runtime_error("El punto de control no corresponde a esta máquina: " + path);
+  }
+
+  input.resize(header.input_size);
+  if (!readBytes(file, &input[0], input.size())) {
+    throw std::runtime_error("Punto de control inválido: " + path);
+  }
+  for (auto& tape : machine.tapes_) {
+    uint64_t sizes[4];
+    if (!readBytes(file, sizes, sizeof(sizes)) || sizes[0] >= sizes[1] || sizes[2] > sizes[1] ||
+        sizes[3] > sizes[1] - sizes[2]) {
+      throw std::runtime_error("Punto de control inválido: " + path);
+    }
+    std::string content(sizes[1], machine.blank_symbol_);
+    if (!readBytes(file, &content[sizes[2]], sizes[3])) {
+      throw std::runtime_error("Punto de control inválido: " + path);
+    }
+    tape.load(content, static_cast<int>(sizes[0]));
+  }
+
+  machine.current_state_ = header.state;
+  machine.step_count_ = header.step_count;
+  machine.halted_ = false;
+  machine.status_ = RunStatus::STEP_LIMIT;
+  machine.cycle_period_ = 0;
+  machine.trace_open_ = false;
+  return header.input_index;
+}
@@ -0,0 +1,333 @@
+#include "../include/CompiledMachine.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+/**
+ * @brief Compila la definición de una máquina a su representación intermedia
+ * @param states Conjunto de estados Q (el índice de cada estado es su posición en el conjunto)
+ * @param tape_alphabet Alfabeto de cinta Γ
+ * @param initial_state Estado inicial s
+ * @param blank_symbol Símbolo blanco b
+ * @param final_states Conjunto de estados finales F
+ * @param num_tapes Número de cintas
+ * @param transitions Transiciones de δ ya validadas, en orden de definición
+ * @throws std::invalid_argument si una transición referencia un estado que no pertenece a Q
+ */
+CompiledMachine::CompiledMachine(const std::set<std::string>& states,
+                                 const Alphabet& tape_alphabet,
+                                 const std::string& initial_state,
+                                 char blank_symbol,
+                                 const std::set<std::string>& final_states,
+                                 size_t num_tapes,
+                                 const std::vector<Transition>& transitions)
+  : state_names_(states.begin(), states.end()),
+    final_(states.size(), 0),
+    initial_state_(0),
+    blank_symbol_(blank_symbol),
+    num_tapes_(num_tapes),
+    wildcards_(false),
+    num_transitions_(transitions.size()),
+    record_size_(sizeof(uint32_t) + 2 * num_tapes),
+    key_size_(sizeof(uint32_t) + num_tapes),
+    record_data_(nullptr),
+    key_data_(nullptr) {
+
+  // Alinear los registros a 4 bytes para que el estado siguiente quede alineado
+  record_size_ = (record_size_ + 3) & ~size_t(3);
+  key_size_ = (key_size_ + 3) & ~size_t(3);
+
+  initial_state_ = getStateIndex(initial_state);
+  for (const auto& state : final_states) {
+    final_[getStateIndex(state)] = 1;
+  }
+
+  records_.assign(num_transitions_ * record_size_, 0);
+  keys_.assign(num_transitions_ * key_size_, 0);
+  record_data_ = records_.data();
+  key_data_ = keys_.data();
+  for (size_t i = 0; i < transitions.size(); ++i) {
+    const Transition& transition = transitions[i];
+    uint8_t* record = records_.data() + i * record_size_;
+    uint8_t* key = keys_.data() + i * key_size_;
+
+    uint32_t next = getStateIndex(transition.getNextState());
+    std::memcpy(record, &next, sizeof(next));
+    for (size_t tape = 0; tape < num_tapes_; ++tape) {
+      record[sizeof(uint32_t) + tape] = static_cast<uint8_t>(transition.getWriteSymbols()[tape]);
+      record[sizeof(uint32_t) + num_tapes_ + tape] = static_cast<uint8_t>(transition.getMovements()[tape]);
+    }
+
+    uint32_t state = getStateIndex(transition.getCurrentState());
+    std::memcpy(key, &state, sizeof(state));
+    std::memcpy(key + sizeof(uint32_t), transition.getReadSymbols().data(), num_tapes_);
+  }
+
+  findWildcards(tape_alphabet);
+  buildTable(tape_alphabet, nullptr);
+  findScanLoops(tape_alphabet);
+  findAlternatives();
+}
+
+/**
+ * @brief Constructor vacío, usado por MachineImage para cargar una imagen binaria
+ */
+CompiledMachine::CompiledMachine()
+  : initial_state_(0), blank_symbol_('.'), num_tapes_(0), wildcards_(false), num_transitions_(0), record_size_(0), key_size_(0),
+    record_data_(nullptr), key_data_(nullptr) {}
+
+/**
+ * @brief Comprueba si una transición es un paso de barrido desde una configuración dada
+ * @param transition Transición (puede ser TransitionTable::kNoTransition)
+ * @param state Estado de partida
+ * @param symbols Símbolos leídos
+ * @param tape Cinta que mueve la transición
+ * @return true si vuelve a state, escribe los mismos símbolos que lee y mueve solo la cinta tape
+ */
+bool CompiledMachine::isScanStep(int32_t transition, uint32_t state, const char* symbols, size_t& tape) const {
+  if (transition == TransitionTable::kNoTransition || getNextState(transition) != state) {
+    return false;
+  }
+  size_t moving = 0;
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    if (getWriteSymbol(transition, i, symbols[i]) != symbols[i]) {
+      return false;
+    }
+    if (getMovement(transition, i) != Movement::STAY) {
+      tape = i;
+      moving++;
+    }
+  }
+  return moving == 1;
+}
+
+/**
+ * @brief Determina si alguna transición lee o escribe el comodín
+ * @param tape_alphabet Alfabeto de cinta Γ (si contiene el comodín, es un símbolo más)
+ */
+void CompiledMachine::findWildcards(const Alphabet& tape_alphabet) {
+  wildcards_ = false;
+  if (tape_alphabet.contains(Transition::kWildcard)) {
+    return;
+  }
+  for (size_t i = 0; i < num_transitions_ && !wildcards_; ++i) {
+    const char* writes = getWriteSymbols(static_cast<int32_t>(i));
+    wildcards_ = std::find(getKeySymbols(i), getKeySymbols(i) + num_tapes_, Transition::kWildcard) !=
+                     getKeySymbols(i) + num_tapes_ ||
+                 std::find(writes, writes + num_tapes_, Transition::kWildcard) != writes + num_tapes_;
+  }
+}
+
+/**
+ * @brief Construye la tabla de despacho a partir de las claves
+ * @param tape_alphabet Alfabeto de cinta Γ
+ * @param external_dense Tabla densa de una imagen binaria (nullptr para construirla)
+ *
+ * La representación de la tabla exacta se elige con el número de claves sin comodines, de modo
+ * que una δ escrita casi solo con comodines no reserva la tabla densa de todo |Q|·|Γ|^k.
+ */
+void CompiledMachine::buildTable(const Alphabet& tape_alphabet, const int32_t* external_dense) {
+  size_t exact_keys = 0;
+  for (size_t i = 0; i < num_transitions_; ++i) {
+    exact_keys += std::none_of(getKeySymbols(i), getKeySymbols(i) + num_tapes_,
+                               [this](char symbol) { return isWildcard(symbol); });
+  }
+  table_ = TransitionTable(state_names_.size(), tape_alphabet, num_tapes_, external_dense, exact_keys);
+
+  // Con una tabla densa externa solo se insertan de verdad las claves con comodines (patrones)
+  for (size_t i = 0; i < num_transitions_; ++i) {
+    std::vector<char> symbols(getKeySymbols(i), getKeySymbols(i) + num_tapes_);
+    table_.insert(getKeyState(i), symbols, static_cast<int32_t>(i));
+  }
+}
+
+/**
+ * @brief Detecta los bucles de barrido de cada transición
+ * @param tape_alphabet Alfabeto de cinta Γ
+ *
+ * Para cada transición que es un paso de barrido sobre la cinta t, el conjunto del barrido son
+ * los símbolos x de Γ tales que, con las demás cintas leyendo lo mismo, la transición que se
+ * aplica al leer x en la cinta t también es un paso de barrido de t en la misma dirección.
+ *
+ * Una transición con comodines es un paso de barrido si escribe el comodín en esas cintas (deja
+ * cada celda como estaba). Si otras cintas leen un comodín, lo que leen se conoce solo al
+ * ejecutar: x entra en el conjunto si lo cumple para todos los símbolos de esas cintas, y el
+ * bucle se descarta si la transición puede aplicarse con un símbolo x que no está en él.
+ */
+void CompiledMachine::findScanLoops(const Alphabet& tape_alphabet) {
+  const std::string gamma = tape_alphabet.getSymbols();
+  scan_loop_of_.assign(num_transitions_, -1);
+  scan_loops_.clear();
+  for (size_t i = 0; i < num_transitions_; ++i) {
+    uint32_t state = getKeyState(i);
+    std::vector<char> symbols(getKeySymbols(i), getKeySymbols(i) + num_tapes_);
+    int32_t index = static_cast<int32_t>(i);
+    size_t tape = 0;
+    if (!isScanStep(index, state, symbols.data(), tape)) {
+      continue;
+    }
+
+    // Cintas distintas de la del barrido que leen un comodín y número de combinaciones a probar
+    std::vector<size_t> free_tapes;
+    size_t combinations = 1;
+    for (size_t j = 0; j < num_tapes_; ++j) {
+      if (j != tape && isWildcard(symbols[j])) {
+        free_tapes.push_back(j);
+        combinations = combinations > kMaxScanProbes / gamma.size() ? kMaxScanProbes + 1
+                                                                    : combinations * gamma.size();
+      }
+    }
+    if (combinations > kMaxScanProbes ||
+        (free_tapes.empty() && !isWildcard(symbols[tape]) && table_.find(state, symbols.data()) != index)) {
+      continue;
+    }
+
+    ScanLoop loop{tape, getMovement(index, tape), SymbolSet()};
+    bool sound = true;
+    for (char symbol : gamma) {
+      symbols[tape] = symbol;
+      bool scans = true;
+      bool applies = false;
+      for (size_t combination = 0; combination < combinations; ++combination) {
+        for (size_t j = 0, rest = combination; j < free_tapes.size(); ++j, rest /= gamma.size()) {
+          symbols[free_tapes[j]] = gamma[rest % gamma.size()];
+        }
+        int32_t other = table_.find(state, symbols.data());
+        size_t other_tape = 0;
+        applies = applies || other == index;
+        scans = scans && isScanStep(other, state, symbols.data(), other_tape) && other_tape == tape &&
+                getMovement(other, tape) == loop.movement;
+      }
+      if (scans) {
+        loop.symbols.insert(symbol);
+      } else if (applies) {
+        sound = false;
+        break;
+      }
+    }
+    if (!sound) {
+      continue;
+    }
+    scan_loop_of_[i] = static_cast<int32_t>(scan_loops_.size());
+    scan_loops_.push_back(loop);
+  }
+}
+
+/**
+ * @brief Enlaza las transiciones que comparten estado y símbolos leídos (máquinas no deterministas)
+ *
+ * La tabla de despacho devuelve la primera transición definida para cada clave; alternative_of_
+ * enlaza cada una con la siguiente de la misma clave en orden de definición. Si la máquina es
+ * determinista el vector queda vacío.
+ */
+void CompiledMachine::findAlternatives() {
+  alternative_of_.clear();
+  std::unordered_map<std::string, int32_t> last_of_key;
+  for (size_t i = 0; i < num_transitions_; ++i) {
+    std::string key(reinterpret_cast<const char*>(key_data_ + i * key_size_), key_size_);
+    auto inserted = last_of_key.emplace(key, static_cast<int32_t>(i));
+    if (inserted.second) {
+      continue;
+    }
+    if (alternative_of_.empty()) {
+      alternative_of_.assign(num_transitions_, TransitionTable::kNoTransition);
+    }
+    alternative_of_[inserted.first->second] = static_cast<int32_t>(i);
+    inserted.first->second = static_cast<int32_t>(i);
+  }
+}
+
+/**
+ * @brief Indica si ninguna clave (estado y símbolos leídos) tiene más de una transición
+ * @return true si la máquina es determinista
+ */
+bool CompiledMachine::isDeterministic() const {
+  return alternative_of_.empty();
+}
+
+/**
+ * @brief Obtiene el número de bucles de barrido detectados
+ * @return Número de transiciones que se ejecutan como barrido
+ */
+size_t CompiledMachine::getNumScanLoops() const {
+  return scan_loops_.size();
+}
+
+/**
+ * @brief Obtiene el número de estados
+ * @return |Q|
+ */
+size_t CompiledMachine::getNumStates() const {
+  return state_names_.size();
+}
+
+/**
+ * @brief Obtiene el número de cintas
+ * @return Número de cintas
+ */
+size_t CompiledMachine::getNumTapes() const {
+  return num_tapes_;
+}
+
+/**
+ * @brief Obtiene el número de transiciones compiladas
+ * @return |δ|
+ */
+size_t CompiledMachine::getNumTransitions() const {
+  return num_transitions_;
+}
+
+/**
+ * @brief Obtiene el identificador del estado inicial
+ * @return Índice del estado inicial
+ */
+uint32_t CompiledMachine::getInitialState() const {
+  return initial_state_;
+}
+
+/**
+ * @brief Obtiene el símbolo blanco
+ * @return Símbolo blanco b
+ */
+char CompiledMachine::getBlankSymbol() const {
+  return blank_symbol_;
+}
+
+/**
+ * @brief Obtiene el identificador de un estado a partir de su nombre
+ * @param name Nombre del estado
+ * @return Índice del estado
+ * @throws std::invalid_argument si el estado no pertenece a Q
+ */
+uint32_t CompiledMachine::getStateIndex(const std::string& name) const {
+  auto it = std::lower_bound(state_names_.begin(), state_names_.end(), name);
+  if (it == state_names_.end() || *it != name) {
+    throw std::invalid_argument("El estado " + name + " no pertenece a Q");
+  }
+  return static_cast<uint32_t>(it - state_names_.begin());
+}
+
+/**
+ * @brief Obtiene el nombre de un estado a partir de su identificador
+ * @param state Índice del estado
+ * @return Nombre del estado
+ */
+const std::string& CompiledMachine::getStateName(uint32_t state) const {
+  return state_names_[state];
+}
+
+/**
+ * @brief Reconstruye una transición de δ a partir de su forma compilada
+ * @param index Índice de la transición
+ * @return Transición con los nombres de estado originales
+ */
+Transition CompiledMachine::getTransition(size_t index) const {
+  int32_t transition = static_cast<int32_t>(index);
+  std::vector<char> read(getKeySymbols(index), getKeySymbols(index) + num_tapes_);
+  std::vector<char> write(getWriteSymbols(transition), getWriteSymbols(transition) + num_tapes_);
+  std::vector<Movement> movements;
+  for (size_t tape = 0; tape < num_tapes_; ++tape) {
+    movements.push_back(getMovement(transition, tape));
+  }
+  return Transition(getStateName(getKeyState(index)), read, getStateName(getNextState(transition)), write, movements);
+}
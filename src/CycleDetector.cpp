@@ -0,0 +1,86 @@
+#include "../include/CycleDetector.hpp"
+
+/**
+ * @brief Constructor del detector
+ * @param blank_symbol Símbolo blanco (las celdas blancas no forman parte del hash)
+ */
+CycleDetector::CycleDetector(char blank_symbol)
+  : blank_symbol_(blank_symbol), num_tapes_(0), hash_(0), checkpoint_(), power_(1), distance_(0), period_(0) {}
+
+/**
+ * @brief Inicializa el detector con la configuración inicial
+ * @param state Estado inicial
+ * @param tapes Cintas de la máquina
+ * @param num_tapes Número de cintas
+ *
+ * La posición absoluta de cada cabezal parte de 0; las celdas se numeran respecto a ella.
+ */
+void CycleDetector::start(uint32_t state, const Tape* tapes, size_t num_tapes) {
+  num_tapes_ = num_tapes;
+  heads_.assign(num_tapes_, 0);
+  hash_ = 0;
+  for (size_t t = 0; t < num_tapes_; ++t) {
+    hash_ ^= headKey(t, 0);
+    size_t offset;
+    std::string_view content = tapes[t].getNonBlankView(offset);
+    long first = static_cast<long>(offset) - tapes[t].getHeadPosition();
+    for (size_t i = 0; i < content.size(); ++i) {
+      if (content[i] != blank_symbol_) {
+        hash_ ^= cellKey(t, first + static_cast<long>(i), content[i]);
+      }
+    }
+  }
+  takeSnapshot(checkpoint_, hash_ ^ stateKey(state), state, tapes);
+  power_ = 1;
+  distance_ = 0;
+  period_ = 0;
+}
+
+/**
+ * @brief Obtiene el periodo del ciclo detectado
+ * @return Pasos entre dos apariciones de la configuración repetida (0 si no se ha detectado)
+ */
+size_t CycleDetector::getPeriod() const {
+  return period_;
+}
+
+/**
+ * @brief Guarda la configuración actual sin los blancos de los extremos de cada cinta
+ * @param snapshot Configuración resultante
+ * @param hash Hash de la configuración
+ * @param state Estado actual
+ * @param tapes Cintas de la máquina
+ */
+void CycleDetector::takeSnapshot(Snapshot& snapshot, uint64_t hash, uint32_t state, const Tape* tapes) const {
+  snapshot.hash = hash;
+  snapshot.state = state;
+  snapshot.heads = heads_;
+  snapshot.first_cells.resize(num_tapes_);
+  snapshot.cells.resize(num_tapes_);
+  for (size_t t = 0; t < num_tapes_; ++t) {
+    size_t first;
+    std::string_view content = tapes[t].getNonBlankView(first);
+    if (content.empty()) {
+      snapshot.first_cells[t] = 0;
+      snapshot.cells[t].clear();
+      continue;
+    }
+    snapshot.first_cells[t] = heads_[t] - tapes[t].getHeadPosition() + static_cast<long>(first);
+    snapshot.cells[t].assign(content);
+  }
+}
+
+/**
+ * @brief Compara la configuración actual con la de control
+ * @param state Estado actual
+ * @param tapes Cintas de la máquina
+ * @return true si ambas configuraciones son idénticas
+ */
+bool CycleDetector::matches(uint32_t state, const Tape* tapes) const {
+  if (state != checkpoint_.state || heads_ != checkpoint_.heads) {
+    return false;
+  }
+  Snapshot current;
+  takeSnapshot(current, checkpoint_.hash, state, tapes);
+  return current.first_cells == checkpoint_.first_cells && current.cells == checkpoint_.cells;
+}
@@ -0,0 +1,247 @@
+#include "../include/ExecutionProfile.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Escapa un texto para incluirlo entre comillas en JSON
+ */
+std::string jsonString(const std::string& text) {
+  std::string result = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      const char* hex = "0123456789abcdef";
+      result += "\\u00";
+      result += hex[(c >> 4) & 0xF];
+      result += hex[c & 0xF];
+    } else {
+      result += c;
+    }
+  }
+  return result + "\"";
+}
+
+/**
+ * @brief Escapa un campo CSV (entre comillas, duplicando las comillas internas)
+ */
+std::string csvField(const std::string& text) {
+  std::string result = "\"";
+  for (char c : text) {
+    if (c == '"') {
+      result += '"';
+    }
+    result += c;
+  }
+  return result + "\"";
+}
+
+}  // namespace
+
+/**
+ * @brief Crea un perfil vacío para una máquina compilada
+ * @param program Máquina compilada (da nombre a estados y transiciones al exportar)
+ */
+ExecutionProfile::ExecutionProfile(std::shared_ptr<const CompiledMachine> program)
+  : program_(std::move(program)),
+    state_hits_(program_->getNumStates(), 0),
+    transition_hits_(program_->getNumTransitions(), 0),
+    tapes_(program_->getNumTapes()) {
+  state_bits_ = 1;
+  while (state_bits_ < 32 && (uint64_t(1) << state_bits_) <= program_->getNumStates()) {
+    ++state_bits_;
+  }
+  depth_ = std::min(kFoldedDepth, size_t(64 / state_bits_));
+  stack_mask_ = depth_ * state_bits_ == 64 ? ~uint64_t(0) : (uint64_t(1) << (depth_ * state_bits_)) - 1;
+}
+
+/**
+ * @brief Empieza una ejecución: la secuencia de estados de las pilas plegadas vuelve a estar vacía
+ */
+void ExecutionProfile::beginRun() {
+  ++runs_;
+  stack_ = 0;
+}
+
+/**
+ * @brief Suma los contadores de otro perfil de la misma máquina
+ * @param other Perfil a sumar (por ejemplo, el de otro hilo)
+ * @throws std::invalid_argument si los perfiles son de máquinas distintas
+ */
+void ExecutionProfile::merge(const ExecutionProfile& other) {
+  if (other.program_ != program_) {
+    throw std::invalid_argument("Solo se pueden sumar perfiles de la misma máquina compilada");
+  }
+  steps_ += other.steps_;
+  runs_ += other.runs_;
+  for (size_t i = 0; i < state_hits_.size(); ++i) {
+    state_hits_[i] += other.state_hits_[i];
+  }
+  for (size_t i = 0; i < transition_hits_.size(); ++i) {
+    transition_hits_[i] += other.transition_hits_[i];
+  }
+  for (size_t i = 0; i < tapes_.size(); ++i) {
+    tapes_[i].travel += other.tapes_[i].travel;
+    tapes_[i].expand_left += other.tapes_[i].expand_left;
+    tapes_[i].expand_right += other.tapes_[i].expand_right;
+  }
+  for (const auto& entry : other.folded_) {
+    folded_[entry.first] += entry.second;
+  }
+}
+
+/**
+ * @brief Obtiene el número de pasos perfilados
+ * @return Pasos de todas las ejecuciones (incluido el paso en el que se detiene cada una)
+ */
+uint64_t ExecutionProfile::getSteps() const {
+  return steps_;
+}
+
+/**
+ * @brief Obtiene el número de ejecuciones perfiladas
+ * @return Número de ejecuciones
+ */
+uint64_t ExecutionProfile::getRuns() const {
+  return runs_;
+}
+
+/**
+ * @brief Obtiene los pasos dados en un estado
+ * @param state Identificador del estado
+ * @return Número de pasos
+ */
+uint64_t ExecutionProfile::getStateHits(uint32_t state) const {
+  return state_hits_.at(state);
+}
+
+/**
+ * @brief Obtiene las veces que se aplicó una transición
+ * @param transition Índice de la transición
+ * @return Número de aplicaciones
+ */
+uint64_t ExecutionProfile::getTransitionHits(size_t transition) const {
+  return transition_hits_.at(transition);
+}
+
+/**
+ * @brief Obtiene el recorrido de un cabezal
+ * @param tape Índice de la cinta
+ * @return Número de movimientos L o R
+ */
+uint64_t ExecutionProfile::getHeadTravel(size_t tape) const {
+  return tapes_.at(tape).travel;
+}
+
+/**
+ * @brief Exporta el perfil
+ * @param out Flujo de salida
+ * @param format Formato de exportación
+ */
+void ExecutionProfile::write(std::ostream& out, ProfileFormat format) const {
+  switch (format) {
+    case ProfileFormat::JSON:
+      writeJson(out);
+      break;
+    case ProfileFormat::CSV:
+      writeCsv(out);
+      break;
+    case ProfileFormat::FOLDED:
+      writeFolded(out);
+      break;
+  }
+}
+
+/**
+ * @brief Descompone una pila plegada en sus estados, del más antiguo al más reciente
+ */
+std::vector<uint32_t> ExecutionProfile::unfold(uint64_t stack) const {
+  std::vector<uint32_t> states;
+  uint64_t mask = (uint64_t(1) << state_bits_) - 1;
+  for (size_t i = depth_; i-- > 0;) {
+    uint64_t value = (stack >> (i * state_bits_)) & mask;
+    if (value != 0) {
+      states.push_back(static_cast<uint32_t>(value - 1));
+    }
+  }
+  return states;
+}
+
+/**
+ * @brief Texto de una transición ("q a -> q' b R")
+ */
+std::string ExecutionProfile::transitionName(size_t transition) const {
+  std::string name = program_->getTransition(transition).toString();
+  while (!name.empty() && name.back() == ' ') {
+    name.pop_back();
+  }
+  return name;
+}
+
+/**
+ * @brief Exporta el perfil como un objeto JSON
+ */
+void ExecutionProfile::writeJson(std::ostream& out) const {
+  out << "{\n  \"runs\": " << runs_ << ",\n  \"steps\": " << steps_ << ",\n  \"states\": [";
+  for (uint32_t state = 0; state < state_hits_.size(); ++state) {
+    out << (state == 0 ? "\n" : ",\n") << "    {\"state\": " << jsonString(program_->getStateName(state))
+        << ", \"hits\": " << state_hits_[state] << "}";
+  }
+  out << "\n  ],\n  \"transitions\": [";
+  for (size_t i = 0; i < transition_hits_.size(); ++i) {
+    out << (i == 0 ? "\n" : ",\n") << "    {\"index\": " << i << ", \"transition\": "
+        << jsonString(transitionName(i)) << ", \"hits\": " << transition_hits_[i] << "}";
+  }
+  out << "\n  ],\n  \"tapes\": [";
+  for (size_t i = 0; i < tapes_.size(); ++i) {
+    out << (i == 0 ? "\n" : ",\n") << "    {\"tape\": " << (i + 1) << ", \"head_travel\": " << tapes_[i].travel
+        << ", \"expand_left\": " << tapes_[i].expand_left << ", \"expand_right\": " << tapes_[i].expand_right << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+/**
+ * @brief Exporta el perfil como CSV: una fila por contador (tipo, índice, nombre, contador, valor)
+ */
+void ExecutionProfile::writeCsv(std::ostream& out) const {
+  out << "kind,index,name,counter,value\n";
+  out << "machine,0,,runs," << runs_ << "\n";
+  out << "machine,0,,steps," << steps_ << "\n";
+  for (uint32_t state = 0; state < state_hits_.size(); ++state) {
+    out << "state," << state << "," << csvField(program_->getStateName(state)) << ",hits," << state_hits_[state]
+        << "\n";
+  }
+  for (size_t i = 0; i < transition_hits_.size(); ++i) {
+    out << "transition," << i << "," << csvField(transitionName(i)) << ",hits," << transition_hits_[i] << "\n";
+  }
+  for (size_t i = 0; i < tapes_.size(); ++i) {
+    out << "tape," << (i + 1) << ",,head_travel," << tapes_[i].travel << "\n";
+    out << "tape," << (i + 1) << ",,expand_left," << tapes_[i].expand_left << "\n";
+    out << "tape," << (i + 1) << ",,expand_right," << tapes_[i].expand_right << "\n";
+  }
+}
+
+/**
+ * @brief Exporta las pilas plegadas, una por línea y ordenadas: "q0;q1;q2 pasos"
+ */
+void ExecutionProfile::writeFolded(std::ostream& out) const {
+  std::vector<std::pair<std::string, uint64_t>> lines;
+  lines.reserve(folded_.size());
+  for (const auto& entry : folded_) {
+    std::string line;
+    for (uint32_t state : unfold(entry.first)) {
+      if (!line.empty()) {
+        line += ';';
+      }
+      line += program_->getStateName(state);
+    }
+    lines.emplace_back(std::move(line), entry.second);
+  }
+  std::sort(lines.begin(), lines.end());
+  for (const auto& line : lines) {
+    out << line.first << " " << line.second << "\n";
+  }
+}
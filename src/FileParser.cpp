@@ -1,4 +1,6 @@
 #include "../include/FileParser.hpp"
+#include "../include/MachineImage.hpp"
+#include "../include/MappedInput.hpp"
 #include <algorithm>
 #include <cctype>
 
@@ -113,6 +115,9 @@ TuringMachine FileParser::parseMachineDefinition(const std::string& filename) {
       }
     }
 
+    // 9. Compilar la máquina a su representación intermedia
+    tm.compile();
+
     file.close();
     return tm;
 
@@ -122,6 +127,82 @@ TuringMachine FileParser::parseMachineDefinition(const std::string& filename) {
   }
 }
 
+namespace {
+
+/**
+ * @brief Parsea una definición y le aplica la optimización pedida
+ * @param filename Ruta al archivo de definición
+ * @param optimization Nivel de optimización
+ * @param report Recibe el informe de la optimización (con NONE, el de una pasada que no elimina nada)
+ * @return TuringMachine optimizada y compilada
+ */
+TuringMachine parseAndOptimize(const std::string& filename, OptimizationLevel optimization,
+                               OptimizationReport& report) {
+  TuringMachine tm = FileParser::parseMachineDefinition(filename);
+  if (optimization != OptimizationLevel::NONE) {
+    report = MachineOptimizer::optimize(tm, optimization == OptimizationLevel::MERGE_STATES);
+  } else {
+    std::shared_ptr<const CompiledMachine> program = tm.getProgram();
+    report = OptimizationReport();
+    report.states_before = report.states_after = program->getNumStates();
+    report.transitions_before = report.transitions_after = program->getNumTransitions();
+  }
+  return tm;
+}
+
+}  // namespace
+
+/**
+ * @brief Carga una definición de MT usando la imagen binaria precompilada si está al día
+ * @param filename Ruta al archivo de definición (texto)
+ * @param use_cache false para parsear siempre el texto sin leer ni escribir la imagen
+ * @param optimization Optimización que se aplica a la máquina (MachineOptimizer)
+ * @param report Si no es nulo, recibe el informe de la optimización
+ * @return TuringMachine configurada según el archivo
+ * @throws std::runtime_error si el archivo no existe o el formato es inválido
+ *
+ * La imagen se guarda junto al fichero de texto con la extensión .mtc, ya optimizada, y se
+ * invalida con el hash del contenido del texto y el nivel de optimización; el informe se lee de
+ * la imagen, así que una carga desde ella no repite la pasada. Si no existe, está desfasada, es
+ * de otro nivel o no se puede leer, se parsea y optimiza el texto y se intenta escribir una imagen
+ * nueva; no poder escribirla no es un error.
+ */
+TuringMachine FileParser::loadMachineDefinition(const std::string& filename, bool use_cache,
+                                                OptimizationLevel optimization, OptimizationReport* report) {
+  OptimizationReport result;
+  if (report == nullptr) {
+    report = &result;
+  }
+  if (!use_cache) {
+    return parseAndOptimize(filename, optimization, *report);
+  }
+
+  uint64_t source_hash;
+  try {
+    MappedInput source(filename);
+    source_hash = MachineImage::hashSource(source.getData());
+  } catch (const std::exception&) {
+    return parseAndOptimize(filename, optimization, *report);
+  }
+
+  std::string image_path = filename + ".mtc";
+  if (MachineImage::isCurrent(image_path, source_hash, optimization)) {
+    try {
+      return MachineImage::read(image_path, report);
+    } catch (const std::exception&) {
+      // Imagen ilegible: se regenera a partir del texto
+    }
+  }
+
+  TuringMachine tm = parseAndOptimize(filename, optimization, *report);
+  try {
+    MachineImage::write(image_path, tm, source_hash, optimization, *report);
+  } catch (const std::exception&) {
+    // La imagen es solo una caché
+  }
+  return tm;
+}
+
 /**
  * @brief Lee cadenas de entrada desde un archivo (una por línea)
  * @param filename Ruta al archivo de entrada
@@ -129,20 +210,17 @@ TuringMachine FileParser::parseMachineDefinition(const std::string& filename) {
  * @throws std::runtime_error si el archivo no existe
  */
 std::vector<std::string> FileParser::parseInputStrings(const std::string& filename) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
-    throw std::runtime_error("No se pudo abrir el archivo de entrada: " + filename);
-  }
+  MappedInput input(filename);
 
   std::vector<std::string> input_strings;
-  std::string line;
+  LineReader reader(input.getData());
+  std::string_view line;
   
   // Leer todas las líneas como cadenas de entrada
-  while (std::getline(file, line)) {
-    input_strings.push_back(line);
+  while (reader.next(line)) {
+    input_strings.emplace_back(line);
   }
 
-  file.close();
   return input_strings;
 }
 
@@ -0,0 +1,340 @@
+#include "../include/MachineImage.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Tamaño de un registro alineado a 4 bytes (igual que en CompiledMachine)
+ */
+uint64_t alignedSize(uint64_t size) {
+  return (size + 3) & ~uint64_t(3);
+}
+
+/**
+ * @brief Comprueba que una sección [offset, offset + size) cabe en la imagen
+ */
+bool fits(uint64_t offset, uint64_t size, uint64_t image_size) {
+  return offset <= image_size && size <= image_size - offset;
+}
+
+}  // namespace
+
+/**
+ * @brief Calcula el hash de contenido del fichero de definición (FNV-1a de 64 bits)
+ * @param source Contenido del fichero de texto
+ * @return Hash que identifica la definición y la versión del formato
+ */
+uint64_t MachineImage::hashSource(std::string_view source) {
+  uint64_t hash = 0xCBF29CE484222325ULL ^ kVersion;
+  for (char c : source) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Indica si existe una imagen válida y actual para una definición
+ * @param path Ruta de la imagen
+ * @param source_hash Hash del fichero de texto actual
+ * @param optimization Nivel de optimización pedido
+ * @return true si la imagen existe, es de esta versión y procede de ese mismo contenido optimizado
+ *         con ese mismo nivel
+ */
+bool MachineImage::isCurrent(const std::string& path, uint64_t source_hash, OptimizationLevel optimization) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  Header header;
+  struct stat info;
+  bool current = ::fstat(fd, &info) == 0 &&
+                 ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                 checkHeader(header, static_cast<uint64_t>(info.st_size)) && header.source_hash == source_hash &&
+                 header.optimization == static_cast<uint32_t>(optimization);
+  ::close(fd);
+  return current;
+}
+
+/**
+ * @brief Carga una máquina desde su imagen binaria
+ * @param path Ruta de la imagen
+ * @param report Si no es nulo, recibe el informe de la optimización con la que se guardó
+ * @return Máquina lista para ejecutar
+ * @throws std::runtime_error si la imagen no se puede abrir o no es válida
+ *
+ * La imagen queda proyectada mientras exista alguna copia de la máquina.
+ */
+TuringMachine MachineImage::read(const std::string& path, OptimizationReport* report) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("No se pudo abrir la imagen binaria: " + path);
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error("Imagen binaria inválida: " + path);
+  }
+  size_t size = static_cast<size_t>(info.st_size);
+  void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("No se pudo proyectar la imagen binaria: " + path);
+  }
+  std::shared_ptr<const void> mapping(address, [size](const void* data) {
+    ::munmap(const_cast<void*>(data), size);
+  });
+
+  const char* base = static_cast<const char*>(address);
+  Header header;
+  std::memcpy(&header, base, sizeof(header));
+  if (!checkHeader(header, size)) {
+    throw std::runtime_error("Imagen binaria inválida: " + path);
+  }
+
+  std::shared_ptr<CompiledMachine> program(new CompiledMachine());
+  const char* names = base + header.names_offset;
+  const char* names_end = names + header.names_size;
+  while (names < names_end) {
+    size_t length = ::strnlen(names, static_cast<size_t>(names_end - names));
+    program->state_names_.emplace_back(names, length);
+    names += length + 1;
+  }
+  if (program->state_names_.size() != header.num_states) {
+    throw std::runtime_error("Imagen binaria inválida: " + path);
+  }
+
+  const uint8_t* finals = reinterpret_cast<const uint8_t*>(base + header.finals_offset);
+  program->final_.assign(finals, finals + header.num_states);
+  program->initial_state_ = header.initial_state;
+  program->blank_symbol_ = static_cast<char>(header.blank_symbol);
+  program->num_tapes_ = header.num_tapes;
+  program->num_transitions_ = header.num_transitions;
+  program->record_size_ = header.record_size;
+  program->key_size_ = header.key_size;
+  program->record_data_ = reinterpret_cast<const uint8_t*>(base + header.records_offset);
+  program->key_data_ = reinterpret_cast<const uint8_t*>(base + header.keys_offset);
+
+  for (size_t i = 0; i < program->num_transitions_; ++i) {
+    if (program->getKeyState(i) >= header.num_states ||
+        program->getNextState(static_cast<int32_t>(i)) >= header.num_states) {
+      throw std::runtime_error("Imagen binaria inválida: " + path);
+    }
+    const uint8_t* movements = program->record(static_cast<int32_t>(i)) + sizeof(uint32_t) + header.num_tapes;
+    for (size_t tape = 0; tape < header.num_tapes; ++tape) {
+      if (movements[tape] > static_cast<uint8_t>(Movement::STAY)) {
+        throw std::runtime_error("Imagen binaria inválida: " + path);
+      }
+    }
+  }
+
+  const char* sigma = base + header.input_alphabet_offset;
+  const char* gamma = base + header.tape_alphabet_offset;
+  Alphabet input_alphabet(std::set<char>(sigma, sigma + header.input_alphabet_size));
+  Alphabet tape_alphabet(std::set<char>(gamma, gamma + header.tape_alphabet_size));
+
+  const int32_t* dense = header.dense_size > 0 ? reinterpret_cast<const int32_t*>(base + header.dense_offset) : nullptr;
+  for (uint64_t i = 0; i < header.dense_size; ++i) {
+    if (dense[i] != TransitionTable::kNoTransition &&
+        (dense[i] < 0 || static_cast<uint64_t>(dense[i]) >= header.num_transitions)) {
+      throw std::runtime_error("Imagen binaria inválida: " + path);
+    }
+  }
+  program->findWildcards(tape_alphabet);
+  program->buildTable(tape_alphabet, dense);
+  if (program->table_.getDenseSize() != header.dense_size) {
+    throw std::runtime_error("Imagen binaria inválida: " + path);
+  }
+
+  const int32_t* scan_loop_of = reinterpret_cast<const int32_t*>(base + header.scan_loop_of_offset);
+  const ScanRecord* scan_loops = reinterpret_cast<const ScanRecord*>(base + header.scan_loops_offset);
+  const int32_t* alternatives = reinterpret_cast<const int32_t*>(base + header.alternatives_offset);
+  for (uint64_t i = 0; i < header.num_scan_loops; ++i) {
+    if (scan_loops[i].tape >= header.num_tapes || scan_loops[i].movement > static_cast<uint32_t>(Movement::STAY)) {
+      throw std::runtime_error("Imagen binaria inválida: " + path);
+    }
+    CompiledMachine::ScanLoop loop{scan_loops[i].tape, static_cast<Movement>(scan_loops[i].movement), SymbolSet()};
+    for (unsigned code = 0; code < 256; ++code) {
+      if ((scan_loops[i].symbols[code >> 6] >> (code & 63)) & 1) {
+        loop.symbols.insert(static_cast<char>(code));
+      }
+    }
+    program->scan_loops_.push_back(loop);
+  }
+  program->scan_loop_of_.assign(scan_loop_of, scan_loop_of + header.num_transitions);
+  program->alternative_of_.assign(alternatives, alternatives + header.alternatives_size);
+  for (size_t i = 0; i < program->num_transitions_; ++i) {
+    int32_t scan = program->scan_loop_of_[i];
+    if (scan < -1 || (scan >= 0 && static_cast<uint64_t>(scan) >= header.num_scan_loops)) {
+      throw std::runtime_error("Imagen binaria inválida: " + path);
+    }
+    // Cada alternativa es posterior a su transición, así que las cadenas siempre terminan
+    if (!program->alternative_of_.empty() && program->alternative_of_[i] != TransitionTable::kNoTransition &&
+        (program->alternative_of_[i] <= static_cast<int32_t>(i) ||
+         static_cast<size_t>(program->alternative_of_[i]) >= program->num_transitions_)) {
+      throw std::runtime_error("Imagen binaria inválida: " + path);
+    }
+  }
+  program->storage_ = std::move(mapping);
+
+  if (report != nullptr) {
+    report->states_before = header.states_before;
+    report->states_after = header.num_states;
+    report->unreachable_states = header.unreachable_states;
+    report->merged_states = header.merged_states;
+    report->transitions_before = header.transitions_before;
+    report->transitions_after = header.num_transitions;
+  }
+
+  return TuringMachine(std::move(program), input_alphabet, tape_alphabet);
+}
+
+/**
+ * @brief Guarda la imagen binaria de una máquina compilada
+ * @param path Ruta de la imagen
+ * @param machine Máquina compilada
+ * @param source_hash Hash del fichero de texto del que procede (hashSource)
+ * @param optimization Nivel de optimización que se aplicó a la máquina
+ * @param report Informe de esa optimización (con NONE, el de una pasada que no elimina nada)
+ * @throws std::runtime_error si la imagen no se puede escribir
+ *
+ * Se escribe en un fichero temporal que después se renombra, de modo que otro proceso nunca
+ * lee una imagen a medio escribir.
+ */
+void MachineImage::write(const std::string& path, const TuringMachine& machine, uint64_t source_hash,
+                         OptimizationLevel optimization, const OptimizationReport& report) {
+  if (machine.program_dirty_) {
+    throw std::logic_error("La máquina debe compilarse antes de guardar su imagen");
+  }
+  const CompiledMachine& program = *machine.program_;
+
+  std::string image(sizeof(Header), '\0');
+  auto append = [&image](const void* data, size_t size) {
+    image.resize((image.size() + 7) & ~size_t(7), '\0');
+    uint64_t offset = image.size();
+    image.append(static_cast<const char*>(data), size);
+    return offset;
+  };
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.source_hash = source_hash;
+  header.num_states = static_cast<uint32_t>(program.getNumStates());
+  header.num_tapes = static_cast<uint32_t>(program.num_tapes_);
+  header.num_transitions = static_cast<uint32_t>(program.num_transitions_);
+  header.initial_state = program.initial_state_;
+  header.record_size = static_cast<uint32_t>(program.record_size_);
+  header.key_size = static_cast<uint32_t>(program.key_size_);
+  header.blank_symbol = static_cast<unsigned char>(program.blank_symbol_);
+  header.optimization = static_cast<uint32_t>(optimization);
+  header.states_before = static_cast<uint32_t>(report.states_before);
+  header.unreachable_states = static_cast<uint32_t>(report.unreachable_states);
+  header.merged_states = static_cast<uint32_t>(report.merged_states);
+  header.transitions_before = static_cast<uint32_t>(report.transitions_before);
+
+  std::string names;
+  for (const auto& name : program.state_names_) {
+    names += name;
+    names += '\0';
+  }
+  header.names_offset = append(names.data(), names.size());
+  header.names_size = names.size();
+  header.finals_offset = append(program.final_.data(), program.final_.size());
+
+  std::string sigma = machine.input_alphabet_.getSymbols();
+  std::string gamma = machine.tape_alphabet_.getSymbols();
+  header.input_alphabet_offset = append(sigma.data(), sigma.size());
+  header.input_alphabet_size = sigma.size();
+  header.tape_alphabet_offset = append(gamma.data(), gamma.size());
+  header.tape_alphabet_size = gamma.size();
+
+  header.records_offset = append(program.record_data_, program.num_transitions_ * program.record_size_);
+  header.keys_offset = append(program.key_data_, program.num_transitions_ * program.key_size_);
+  if (program.table_.getDenseData() != nullptr) {
+    header.dense_size = program.table_.getDenseSize();
+    header.dense_offset = append(program.table_.getDenseData(), header.dense_size * sizeof(int32_t));
+  }
+  header.scan_loop_of_offset = append(program.scan_loop_of_.data(), program.scan_loop_of_.size() * sizeof(int32_t));
+  std::vector<ScanRecord> scan_loops(program.scan_loops_.size());
+  for (size_t i = 0; i < scan_loops.size(); ++i) {
+    const CompiledMachine::ScanLoop& loop = program.scan_loops_[i];
+    std::memset(&scan_loops[i], 0, sizeof(ScanRecord));
+    scan_loops[i].tape = static_cast<uint32_t>(loop.tape);
+    scan_loops[i].movement = static_cast<uint32_t>(loop.movement);
+    for (unsigned code = 0; code < 256; ++code) {
+      if (loop.symbols.contains(static_cast<char>(code))) {
+        scan_loops[i].symbols[code >> 6] |= uint64_t(1) << (code & 63);
+      }
+    }
+  }
+  header.scan_loops_offset = append(scan_loops.data(), scan_loops.size() * sizeof(ScanRecord));
+  header.num_scan_loops = scan_loops.size();
+  header.alternatives_size = program.alternative_of_.size();
+  header.alternatives_offset = append(program.alternative_of_.data(), header.alternatives_size * sizeof(int32_t));
+  image.resize((image.size() + 7) & ~size_t(7), '\0');
+  header.image_size = image.size();
+  std::memcpy(&image[0], &header, sizeof(header));
+
+  std::string temporary = path + ".tmp." + std::to_string(::getpid());
+  std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("No se pudo escribir la imagen binaria: " + path);
+  }
+  file.write(image.data(), static_cast<std::streamsize>(image.size()));
+  file.close();
+  if (!file || std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("No se pudo escribir la imagen binaria: " + path);
+  }
+}
+
+/**
+ * @brief Comprueba la cabecera y que todas las secciones caben en la imagen
+ * @param header Cabecera leída
+ * @param file_size Tamaño del fichero
+ * @return true si la imagen es de esta versión y su estructura es coherente
+ */
+bool MachineImage::checkHeader(const Header& header, uint64_t file_size) {
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+      header.byte_order != kByteOrder || header.image_size != file_size) {
+    return false;
+  }
+  if (header.num_states == 0 || header.num_tapes == 0 || header.initial_state >= header.num_states ||
+      header.num_transitions > file_size ||
+      header.record_size != alignedSize(sizeof(uint32_t) + 2 * uint64_t(header.num_tapes)) ||
+      header.key_size != alignedSize(sizeof(uint32_t) + uint64_t(header.num_tapes))) {
+    return false;
+  }
+  if (header.optimization > static_cast<uint32_t>(OptimizationLevel::MERGE_STATES) ||
+      uint64_t(header.states_before) !=
+          uint64_t(header.num_states) + header.unreachable_states + header.merged_states ||
+      header.transitions_before < header.num_transitions) {
+    return false;
+  }
+  return fits(header.names_offset, header.names_size, file_size) &&
+         fits(header.finals_offset, header.num_states, file_size) &&
+         fits(header.input_alphabet_offset, header.input_alphabet_size, file_size) &&
+         fits(header.tape_alphabet_offset, header.tape_alphabet_size, file_size) &&
+         fits(header.records_offset, uint64_t(header.num_transitions) * header.record_size, file_size) &&
+         fits(header.keys_offset, uint64_t(header.num_transitions) * header.key_size, file_size) &&
+         header.dense_size <= file_size && fits(header.dense_offset, header.dense_size * sizeof(int32_t), file_size) &&
+         fits(header.scan_loop_of_offset, uint64_t(header.num_transitions) * sizeof(int32_t), file_size) &&
+         header.num_scan_loops <= header.num_transitions &&
+         fits(header.scan_loops_offset, header.num_scan_loops * sizeof(ScanRecord), file_size) &&
+         (header.alternatives_size == 0 || header.alternatives_size == header.num_transitions) &&
+         fits(header.alternatives_offset, header.alternatives_size * sizeof(int32_t), file_size) &&
+         header.dense_offset % alignof(int32_t) == 0 && header.records_offset % alignof(uint32_t) == 0 &&
+         header.scan_loop_of_offset % alignof(int32_t) == 0 && header.scan_loops_offset % alignof(ScanRecord) == 0 &&
+         header.alternatives_offset % alignof(int32_t) == 0;
+}
@@ -0,0 +1,177 @@
+#include "../include/MachineOptimizer.hpp"
+#include <bitset>
+#include <map>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * @brief Añade a la firma un entero de 32 bits
+ */
+void appendId(std::string& signature, uint32_t id) {
+  signature.append(reinterpret_cast<const char*>(&id), sizeof(id));
+}
+
+}  // namespace
+
+/**
+ * @brief Elimina los estados y transiciones muertos y, si se pide, fusiona los estados equivalentes
+ * @param machine Máquina a optimizar (se recompila solo si cambia)
+ * @param merge_states Fusiona además los estados equivalentes
+ * @return Tamaño de la máquina antes y después de la pasada
+ */
+OptimizationReport MachineOptimizer::optimize(TuringMachine& machine, bool merge_states) {
+  machine.restoreTransitions();
+  const std::vector<Transition>& transitions = machine.transitions_;
+  const size_t num_tapes = machine.num_tapes_;
+  const bool wildcards = !machine.tape_alphabet_.contains(Transition::kWildcard);
+
+  std::vector<std::string> names(machine.states_.begin(), machine.states_.end());
+  std::map<std::string, uint32_t> index;
+  for (uint32_t state = 0; state < names.size(); ++state) {
+    index.emplace_hint(index.end(), names[state], state);
+  }
+  std::vector<uint32_t> source(transitions.size());
+  std::vector<uint32_t> target(transitions.size());
+  for (size_t i = 0; i < transitions.size(); ++i) {
+    source[i] = index.at(transitions[i].getCurrentState());
+    target[i] = index.at(transitions[i].getNextState());
+  }
+  const uint32_t initial = index.at(machine.initial_state_);
+
+  OptimizationReport report;
+  report.states_before = names.size();
+  report.transitions_before = transitions.size();
+
+  // Estados alcanzables y símbolos posibles en cada cinta, hasta el punto fijo
+  std::vector<std::bitset<256>> possible(num_tapes);
+  for (char symbol : machine.input_alphabet_.getSymbols()) {
+    possible[0].set(static_cast<unsigned char>(symbol));
+  }
+  for (size_t tape = 0; tape < num_tapes; ++tape) {
+    possible[tape].set(static_cast<unsigned char>(machine.blank_symbol_));
+  }
+  std::vector<uint8_t> reachable(names.size(), 0);
+  std::vector<uint8_t> live(transitions.size(), 0);
+  reachable[initial] = 1;
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (size_t i = 0; i < transitions.size(); ++i) {
+      if (live[i] || !reachable[source[i]]) {
+        continue;
+      }
+      const std::vector<char>& reads = transitions[i].getReadSymbols();
+      bool fires = true;
+      for (size_t tape = 0; tape < num_tapes && fires; ++tape) {
+        fires = (wildcards && reads[tape] == Transition::kWildcard) ||
+                possible[tape].test(static_cast<unsigned char>(reads[tape]));
+      }
+      if (!fires) {
+        continue;
+      }
+      live[i] = 1;
+      reachable[target[i]] = 1;
+      const std::vector<char>& writes = transitions[i].getWriteSymbols();
+      for (size_t tape = 0; tape < num_tapes; ++tape) {
+        if (!(wildcards && writes[tape] == Transition::kWildcard)) {
+          possible[tape].set(static_cast<unsigned char>(writes[tape]));
+        }
+      }
+      changed = true;
+    }
+  }
+
+  // Transiciones vivas de cada estado en orden de definición: entre patrones con comodines que se
+  // solapan, el despacho depende de ese orden
+  std::vector<uint32_t> alive;
+  std::vector<std::vector<size_t>> outgoing(names.size());
+  for (uint32_t state = 0; state < names.size(); ++state) {
+    if (reachable[state]) {
+      alive.push_back(state);
+    }
+  }
+  for (size_t i = 0; i < transitions.size(); ++i) {
+    if (live[i]) {
+      outgoing[source[i]].push_back(i);
+    }
+  }
+
+  // Refinamiento de particiones: cada ronda separa los estados con distinta firma. Sin fusión,
+  // cada estado vivo es su propio bloque
+  std::vector<uint32_t> block(names.size(), 0);
+  size_t num_blocks = 0;
+  for (uint32_t state : alive) {
+    block[state] = merge_states ? (machine.final_states_.count(names[state]) ? 1 : 0) : num_blocks++;
+  }
+  std::vector<uint32_t> refined(names.size(), 0);
+  std::string signature;
+  while (merge_states) {
+    std::unordered_map<std::string, uint32_t> blocks;
+    for (uint32_t state : alive) {
+      signature.clear();
+      appendId(signature, block[state]);
+      for (size_t i : outgoing[state]) {
+        const Transition& transition = transitions[i];
+        signature.append(transition.getReadSymbols().begin(), transition.getReadSymbols().end());
+        signature.append(transition.getWriteSymbols().begin(), transition.getWriteSymbols().end());
+        for (Movement movement : transition.getMovements()) {
+          signature.push_back(Transition::movementToChar(movement));
+        }
+        appendId(signature, block[target[i]]);
+      }
+      refined[state] = blocks.emplace(signature, static_cast<uint32_t>(blocks.size())).first->second;
+    }
+    bool stable = blocks.size() == num_blocks;
+    num_blocks = blocks.size();
+    block.swap(refined);
+    if (stable) {
+      break;
+    }
+  }
+
+  // Representante de cada bloque: el estado inicial o el primero del bloque en el orden de Q
+  std::vector<uint32_t> representative(num_blocks, UINT32_MAX);
+  for (uint32_t state : alive) {
+    if (representative[block[state]] == UINT32_MAX) {
+      representative[block[state]] = state;
+    }
+  }
+  representative[block[initial]] = initial;
+
+  std::vector<size_t> kept;
+  for (size_t i = 0; i < transitions.size(); ++i) {
+    if (live[i] && representative[block[source[i]]] == source[i]) {
+      kept.push_back(i);
+    }
+  }
+
+  report.states_after = num_blocks;
+  report.unreachable_states = names.size() - alive.size();
+  report.merged_states = alive.size() - num_blocks;
+  report.transitions_after = kept.size();
+  if (report.states_after == report.states_before && report.transitions_after == report.transitions_before) {
+    return report;
+  }
+
+  std::vector<Transition> optimized;
+  optimized.reserve(kept.size());
+  for (size_t i : kept) {
+    const Transition& transition = transitions[i];
+    optimized.emplace_back(transition.getCurrentState(), transition.getReadSymbols(),
+                           names[representative[block[target[i]]]], transition.getWriteSymbols(),
+                           transition.getMovements());
+  }
+  std::set<std::string> states;
+  std::set<std::string> final_states;
+  for (uint32_t state : representative) {
+    states.insert(names[state]);
+    if (machine.final_states_.count(names[state])) {
+      final_states.insert(names[state]);
+    }
+  }
+  machine.states_ = std::move(states);
+  machine.final_states_ = std::move(final_states);
+  machine.transitions_ = std::move(optimized);
+  machine.compile();
+  return report;
+}
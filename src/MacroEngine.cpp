@@ -0,0 +1,330 @@
+#include "../include/MacroEngine.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @brief Constructor del motor
+ * @param program Máquina compilada a simular
+ * @param block_size Número de celdas por bloque (entre 1 y kMaxBlockSize)
+ * @throws std::invalid_argument si el tamaño de bloque no es válido
+ */
+MacroEngine::MacroEngine(const CompiledMachine& program, size_t block_size)
+  : program_(&program), block_size_(block_size), num_tapes_(program.getNumTapes()),
+    blank_symbol_(program.getBlankSymbol()) {
+  if (block_size_ < 1 || block_size_ > kMaxBlockSize) {
+    throw std::invalid_argument("El tamaño de bloque debe estar entre 1 y " + std::to_string(kMaxBlockSize));
+  }
+}
+
+/**
+ * @brief Ejecuta la máquina a partir de la configuración actual de las cintas
+ * @param tapes Cintas de la máquina (se actualizan con la configuración final)
+ * @param state Estado actual (se actualiza con el estado final)
+ * @param step_count Contador de pasos (se actualiza con la misma contabilidad que el intérprete)
+ * @param max_steps Número máximo de pasos
+ * @return true si la máquina se detuvo, false si se alcanzó max_steps
+ */
+bool MacroEngine::run(std::vector<Tape>& tapes, uint32_t& state, size_t& step_count, size_t max_steps) {
+  std::vector<WorkTape> work(num_tapes_);
+  std::vector<long> initial_size(num_tapes_);
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    std::string_view content = tapes[i].getView();
+    work[i].cells.assign(content.begin(), content.end());
+    work[i].offset = 0;
+    work[i].head = tapes[i].getHeadPosition();
+    work[i].min_visited = work[i].head;
+    work[i].max_visited = work[i].head;
+    work[i].min_written = 0;
+    work[i].max_written = 0;
+    work[i].has_written = false;
+    initial_size[i] = static_cast<long>(content.size());
+  }
+
+  bool halted = false;
+  std::string key;
+  std::string blocks;
+  std::vector<long> block_starts(num_tapes_);
+  std::vector<long> offsets(num_tapes_);
+
+  while (!halted && step_count < max_steps) {
+    blocks.clear();
+    key.assign(reinterpret_cast<const char*>(&state), sizeof(state));
+    for (size_t i = 0; i < num_tapes_; ++i) {
+      block_starts[i] = blockStart(work[i].head);
+      offsets[i] = work[i].head - block_starts[i];
+      ensure(work[i], block_starts[i], block_starts[i] + static_cast<long>(block_size_) - 1);
+      blocks.append(cell(work[i], block_starts[i]), block_size_);
+      key += static_cast<char>(offsets[i]);
+    }
+    key += blocks;
+
+    size_t remaining = max_steps - step_count;
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      if (cache_.size() >= kMaxCacheEntries) {
+        cache_.clear();
+      }
+      it = cache_.emplace(key, simulate(state, blocks, offsets, kMaxInnerSteps)).first;
+    }
+
+    if (it->second.steps > remaining || (it->second.halted && it->second.steps == remaining)) {
+      // El macro-paso cacheado no cabe en el presupuesto: simular solo los pasos restantes
+      MacroStep partial = simulate(state, blocks, offsets, remaining);
+      apply(work, block_starts, partial);
+      state = partial.state;
+      step_count += partial.steps;
+      if (partial.halted) {
+        step_count++;
+        halted = true;
+      }
+      break;
+    }
+
+    const MacroStep& step = it->second;
+    uint32_t entry_state = state;
+    apply(work, block_starts, step);
+    state = step.state;
+    step_count += step.steps;
+    if (step.halted) {
+      step_count++;
+      halted = true;
+    } else if (step.state == entry_state && step.steps > 0) {
+      size_t repeats = repeatSweep(work, block_starts, blocks, offsets, step, (max_steps - step_count) / step.steps);
+      step_count += repeats * step.steps;
+    }
+  }
+
+  // Reconstruir la extensión de cada cinta igual que el intérprete: incluye todas las celdas
+  // visitadas y una celda más allá de cada símbolo no blanco escrito en un extremo
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    WorkTape& tape = work[i];
+    long left = std::min(0L, tape.min_visited);
+    long right = std::max(initial_size[i] - 1, tape.max_visited);
+    if (tape.has_written) {
+      left = std::min(left, tape.min_written - 1);
+      right = std::max(right, tape.max_written + 1);
+    }
+    ensure(tape, left, right);
+    tapes[i].load(std::string(cell(tape, left), static_cast<size_t>(right - left + 1)),
+                  static_cast<int>(tape.head - left));
+  }
+
+  return halted;
+}
+
+/**
+ * @brief Ejecuta la máquina dentro de los bloques actuales
+ * @param state Estado de entrada
+ * @param blocks Contenido de los bloques bajo cada cabezal (B celdas por cinta)
+ * @param offsets Posición de cada cabezal dentro de su bloque
+ * @param max_steps Número máximo de pasos a simular
+ * @return Resultado del macro-paso
+ *
+ * Termina cuando un cabezal sale de su bloque, cuando no hay transición aplicable
+ * o al alcanzar max_steps.
+ */
+MacroEngine::MacroStep MacroEngine::simulate(uint32_t state, const std::string& blocks,
+                                             const std::vector<long>& offsets, size_t max_steps) const {
+  MacroStep result;
+  result.state = state;
+  result.halted = false;
+  result.steps = 0;
+  result.blocks = blocks;
+  result.offsets = offsets;
+  result.min_visited = offsets;
+  result.max_visited = offsets;
+  result.min_written.assign(num_tapes_, 0);
+  result.max_written.assign(num_tapes_, 0);
+  result.has_written.assign(num_tapes_, 0);
+
+  const long block_size = static_cast<long>(block_size_);
+  std::vector<char> symbols(num_tapes_);
+  bool inside = true;
+
+  while (inside && result.steps < max_steps) {
+    for (size_t i = 0; i < num_tapes_; ++i) {
+      symbols[i] = result.blocks[i * block_size_ + result.offsets[i]];
+    }
+
+    int32_t transition = program_->findTransition(result.state, symbols.data());
+    if (transition == TransitionTable::kNoTransition) {
+      result.halted = true;
+      break;
+    }
+
+    result.state = program_->getNextState(transition);
+    for (size_t i = 0; i < num_tapes_; ++i) {
+      long& offset = result.offsets[i];
+      char symbol = program_->getWriteSymbol(transition, i, symbols[i]);
+      result.blocks[i * block_size_ + offset] = symbol;
+      if (symbol != blank_symbol_) {
+        if (!result.has_written[i]) {
+          result.min_written[i] = offset;
+          result.max_written[i] = offset;
+          result.has_written[i] = 1;
+        } else {
+          result.min_written[i] = std::min(result.min_written[i], offset);
+          result.max_written[i] = std::max(result.max_written[i], offset);
+        }
+      }
+
+      switch (program_->getMovement(transition, i)) {
+        case Movement::LEFT:
+          offset--;
+          break;
+        case Movement::RIGHT:
+          offset++;
+          break;
+        case Movement::STAY:
+          break;
+      }
+      result.min_visited[i] = std::min(result.min_visited[i], offset);
+      result.max_visited[i] = std::max(result.max_visited[i], offset);
+      if (offset < 0 || offset >= block_size) {
+        inside = false;
+      }
+    }
+    result.steps++;
+  }
+
+  return result;
+}
+
+/**
+ * @brief Aplica un macro-paso a las cintas de trabajo
+ * @param work Cintas de trabajo
+ * @param block_starts Coordenada inicial del bloque de cada cinta
+ * @param step Macro-paso a aplicar
+ */
+void MacroEngine::apply(std::vector<WorkTape>& work, const std::vector<long>& block_starts,
+                        const MacroStep& step) const {
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    WorkTape& tape = work[i];
+    long start = block_starts[i];
+    std::memcpy(cell(tape, start), step.blocks.data() + i * block_size_, block_size_);
+    tape.head = start + step.offsets[i];
+    tape.min_visited = std::min(tape.min_visited, start + step.min_visited[i]);
+    tape.max_visited = std::max(tape.max_visited, start + step.max_visited[i]);
+    if (step.has_written[i]) {
+      if (!tape.has_written) {
+        tape.min_written = start + step.min_written[i];
+        tape.max_written = start + step.max_written[i];
+        tape.has_written = true;
+      } else {
+        tape.min_written = std::min(tape.min_written, start + step.min_written[i]);
+        tape.max_written = std::max(tape.max_written, start + step.max_written[i]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Repite un macro-paso de barrido sobre los bloques idénticos consecutivos
+ * @param work Cintas de trabajo (con el macro-paso ya aplicado)
+ * @param block_starts Coordenada inicial de los bloques en los que se aplicó el macro-paso
+ * @param blocks Contenido de esos bloques antes del macro-paso
+ * @param offsets Posición de los cabezales dentro de esos bloques antes del macro-paso
+ * @param step Macro-paso aplicado (sin cambio de estado)
+ * @param max_repeats Número máximo de repeticiones permitidas por el presupuesto de pasos
+ * @return Número de repeticiones aplicadas
+ *
+ * Solo aplica si el macro-paso cruza un bloque entero de una cinta (entra por un extremo y sale
+ * por el contrario) sin modificar las demás cintas: en ese caso cada bloque siguiente con el mismo
+ * contenido producirá exactamente el mismo macro-paso.
+ */
+size_t MacroEngine::repeatSweep(std::vector<WorkTape>& work, const std::vector<long>& block_starts,
+                                const std::string& blocks, const std::vector<long>& offsets,
+                                const MacroStep& step, size_t max_repeats) const {
+  const long block_size = static_cast<long>(block_size_);
+  size_t sweeping = num_tapes_;
+  long direction = 0;
+
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    long exit_offset = step.offsets[i];
+    if (exit_offset == block_size && offsets[i] == 0) {
+      direction = 1;
+    } else if (exit_offset == -1 && offsets[i] == block_size - 1) {
+      direction = -1;
+    } else if (exit_offset == offsets[i] &&
+               step.blocks.compare(i * block_size_, block_size_, blocks, i * block_size_, block_size_) == 0) {
+      continue;
+    } else {
+      return 0;
+    }
+    if (sweeping != num_tapes_) {
+      return 0;
+    }
+    sweeping = i;
+  }
+  if (sweeping == num_tapes_) {
+    return 0;
+  }
+
+  WorkTape& tape = work[sweeping];
+  const char* original = blocks.data() + sweeping * block_size_;
+  const char* updated = step.blocks.data() + sweeping * block_size_;
+  size_t repeats = 0;
+
+  while (repeats < max_repeats) {
+    long start = block_starts[sweeping] + direction * block_size * static_cast<long>(repeats + 1);
+    ensure(tape, start, start + block_size - 1);
+    char* block = cell(tape, start);
+    if (std::memcmp(block, original, block_size_) != 0) {
+      break;
+    }
+    std::memcpy(block, updated, block_size_);
+    tape.head = start + step.offsets[sweeping];
+    tape.min_visited = std::min(tape.min_visited, start + step.min_visited[sweeping]);
+    tape.max_visited = std::max(tape.max_visited, start + step.max_visited[sweeping]);
+    if (step.has_written[sweeping]) {
+      tape.min_written = std::min(tape.min_written, start + step.min_written[sweeping]);
+      tape.max_written = std::max(tape.max_written, start + step.max_written[sweeping]);
+    }
+    repeats++;
+  }
+
+  return repeats;
+}
+
+/**
+ * @brief Coordenada de inicio del bloque que contiene una posición
+ * @param position Coordenada absoluta
+ * @return Coordenada de la primera celda del bloque
+ */
+long MacroEngine::blockStart(long position) const {
+  const long block_size = static_cast<long>(block_size_);
+  long block = position >= 0 ? position / block_size : -((-position + block_size - 1) / block_size);
+  return block * block_size;
+}
+
+/**
+ * @brief Garantiza que las coordenadas [first, last] existen en la cinta de trabajo
+ * @param tape Cinta de trabajo
+ * @param first Primera coordenada
+ * @param last Última coordenada
+ *
+ * Las celdas nuevas son blancas; el buffer crece al menos al doble hacia el lado necesario.
+ */
+void MacroEngine::ensure(WorkTape& tape, long first, long last) const {
+  if (first + tape.offset < 0) {
+    size_t needed = static_cast<size_t>(-(first + tape.offset));
+    size_t added = std::max(needed, tape.cells.size());
+    tape.cells.insert(tape.cells.begin(), added, blank_symbol_);
+    tape.offset += static_cast<long>(added);
+  }
+  if (last + tape.offset >= static_cast<long>(tape.cells.size())) {
+    size_t needed = static_cast<size_t>(last + tape.offset + 1);
+    tape.cells.resize(std::max(needed, 2 * tape.cells.size()), blank_symbol_);
+  }
+}
+
+/**
+ * @brief Acceso a una celda de la cinta de trabajo (debe existir)
+ * @param tape Cinta de trabajo
+ * @param position Coordenada absoluta
+ * @return Puntero a la celda
+ */
+char* MacroEngine::cell(WorkTape& tape, long position) const {
+  return tape.cells.data() + (position + tape.offset);
+}
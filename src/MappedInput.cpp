@@ -0,0 +1,94 @@
+#include "../include/MappedInput.hpp"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Proyecta el fichero en memoria
+ * @param filename Ruta del fichero de cadenas de entrada
+ * @throws std::runtime_error si el fichero no se puede abrir
+ */
+MappedInput::MappedInput(const std::string& filename)
+  : data_(nullptr), size_(0), mapped_(false) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("No se pudo abrir el archivo de entrada: " + filename);
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+      ::close(fd);
+      return;
+    }
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED) {
+      ::madvise(address, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(address);
+      mapped_ = true;
+    }
+  }
+
+  if (!mapped_) {
+    char block[1 << 16];
+    ssize_t count;
+    while ((count = ::read(fd, block, sizeof(block))) > 0) {
+      buffer_.append(block, static_cast<size_t>(count));
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+  }
+  ::close(fd);
+}
+
+/**
+ * @brief Libera la proyección
+ */
+MappedInput::~MappedInput() {
+  if (mapped_) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+/**
+ * @brief Obtiene el contenido completo del fichero
+ * @return Vista sobre el contenido (válida mientras exista el objeto)
+ */
+std::string_view MappedInput::getData() const {
+  return std::string_view(data_, size_);
+}
+
+/**
+ * @brief Divide el fichero en rangos de bytes alineados a líneas
+ * @param num_chunks Número de rangos deseado
+ * @return Rangos consecutivos no vacíos que cubren todo el fichero (como mucho num_chunks)
+ *
+ * Cada rango termina justo después de un salto de línea (o al final del fichero), así que
+ * recorrer los rangos en orden con LineReader produce exactamente las mismas líneas que
+ * recorrer el fichero completo.
+ */
+std::vector<std::string_view> MappedInput::split(size_t num_chunks) const {
+  std::vector<std::string_view> chunks;
+  std::string_view data = getData();
+  if (num_chunks == 0) {
+    num_chunks = 1;
+  }
+
+  size_t target = data.size() / num_chunks + 1;
+  size_t begin = 0;
+  while (begin < data.size()) {
+    size_t end = begin + target;
+    if (end >= data.size()) {
+      end = data.size();
+    } else {
+      end = data.find('\n', end - 1);
+      end = end == std::string_view::npos ? data.size() : end + 1;
+    }
+    chunks.push_back(data.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
@@ -0,0 +1,627 @@
+#include "../include/NondeterministicSearch.hpp"
+#include "../include/TuringMachine.hpp"
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+namespace {
+
+constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief Guarda en target el mínimo entre su valor y value
+ */
+void storeMin(std::atomic<size_t>& target, size_t value) {
+  size_t current = target.load();
+  while (value < current && !target.compare_exchange_weak(current, value)) {
+  }
+}
+
+}  // namespace
+
+/**
+ * @brief Crea el explorador
+ * @param mode BREADTH_FIRST o ITERATIVE_DEEPENING
+ * @param jobs Número de hilos (con 1 no se crea ningún pool)
+ * @param memory_limit Memoria máxima estimada en bytes de la frontera y las tablas de configuraciones
+ * @throws std::invalid_argument si el modo es DETERMINISTIC o jobs es 0
+ */
+NondeterministicSearch::NondeterministicSearch(SearchMode mode, size_t jobs, size_t memory_limit)
+  : mode_(mode), jobs_(jobs), memory_limit_(memory_limit), program_(nullptr), blank_symbol_('.'), num_tapes_(0) {
+  if (mode_ == SearchMode::DETERMINISTIC || jobs_ == 0) {
+    throw std::invalid_argument("La búsqueda no determinista necesita un modo de exploración y al menos un hilo");
+  }
+  if (jobs_ > 1) {
+    pool_ = std::make_unique<ThreadPool>(jobs_);
+  }
+}
+
+/**
+ * @brief Obtiene el modo de exploración
+ * @return BREADTH_FIRST o ITERATIVE_DEEPENING
+ */
+SearchMode NondeterministicSearch::getMode() const {
+  return mode_;
+}
+
+/**
+ * @brief Explora las configuraciones alcanzables desde la entrada
+ * @param program Máquina compilada
+ * @param input Cadena de entrada (ya validada)
+ * @param max_steps Profundidad máxima (pasos de una rama)
+ * @return Configuración de la rama aceptada o, si no acepta ninguna, la que explica el resultado:
+ *         HALTED con la rama detenida más profunda, NON_HALTING con una configuración repetida si
+ *         no se detiene ninguna, STEP_LIMIT con la primera rama que alcanzó max_steps, o
+ *         MEMORY_LIMIT con la primera rama de la frontera
+ *
+ * Una rama que se detiene cuenta un paso más, como en el ejecutor determinista.
+ */
+SearchResult NondeterministicSearch::run(const CompiledMachine& program, std::string_view input, size_t max_steps) {
+  program_ = &program;
+  blank_symbol_ = program.getBlankSymbol();
+  num_tapes_ = program.getNumTapes();
+  Node root = makeRoot(input);
+  return mode_ == SearchMode::BREADTH_FIRST ? breadthFirst(std::move(root), max_steps)
+                                            : iterativeDeepening(std::move(root), max_steps);
+}
+
+/**
+ * @brief Búsqueda en anchura, nivel a nivel
+ *
+ * Cada nivel se expande en bloques consecutivos de la frontera (una tarea por bloque); si una
+ * rama acepta, los bloques dejan de expandir las ramas posteriores a ella. Los hijos se
+ * deduplican después por fragmentos de la tabla (una tarea por fragmento, que recorre los hijos
+ * en orden y se queda con los de su fragmento), así que siempre se conserva la primera aparición.
+ */
+SearchResult NondeterministicSearch::breadthFirst(Node root, size_t max_steps) {
+  const size_t kMinChunk = 64;
+  const size_t num_shards = pool_ ? 4 * jobs_ : 1;
+
+  std::vector<Visited> visited(num_shards);
+  visited[root.key.low % num_shards].emplace(root.key, 0);
+  size_t num_visited = 1;
+
+  std::vector<Node> frontier;
+  size_t frontier_bytes = nodeBytes(root);
+  frontier.push_back(std::move(root));
+  Node halted;
+  bool has_halted = false;
+  Node repeated;
+  size_t repeat_period = 0;
+  bool has_repeated = false;
+
+  auto parallelFor = [this](size_t count, const std::function<void(size_t)>& body) {
+    if (!pool_ || count == 1) {
+      for (size_t i = 0; i < count; ++i) {
+        body(i);
+      }
+      return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      pool_->submit([&body, i](size_t) { body(i); });
+    }
+    pool_->wait();
+  };
+
+  while (!frontier.empty()) {
+    size_t depth = frontier[0].depth;
+    if (depth >= max_steps) {
+      SearchResult result = makeResult(RunStatus::STEP_LIMIT, frontier[0], depth);
+      result.configurations = num_visited;
+      return result;
+    }
+
+    // Expansión: un bloque de ramas consecutivas por tarea
+    size_t chunk = std::max(kMinChunk, (frontier.size() + 8 * jobs_ - 1) / (8 * jobs_));
+    size_t num_chunks = (frontier.size() + chunk - 1) / chunk;
+    std::vector<std::vector<Node>> children(num_chunks);
+    std::vector<size_t> first_halted(num_chunks, kNone);
+    std::atomic<size_t> accepted(kNone);
+    std::atomic<size_t> level_bytes(0);
+    std::atomic<bool> out_of_memory(false);
+    const size_t level_limit = memory_limit_ - std::min(memory_limit_, frontier_bytes + num_visited * kVisitedEntryBytes);
+    parallelFor(num_chunks, [&](size_t c) {
+      size_t end = std::min(frontier.size(), (c + 1) * chunk);
+      for (size_t i = c * chunk; i < end && i < accepted.load(std::memory_order_relaxed) && !out_of_memory; ++i) {
+        size_t before = children[c].size();
+        expand(frontier[i], children[c]);
+        if (children[c].size() > before) {
+          size_t bytes = 0;
+          for (size_t j = before; j < children[c].size(); ++j) {
+            bytes += nodeBytes(children[c][j]) + kVisitedEntryBytes;
+          }
+          if ((level_bytes += bytes) > level_limit) {
+            out_of_memory = true;
+          }
+          continue;
+        }
+        if (program_->isFinal(frontier[i].state)) {
+          storeMin(accepted, i);
+          break;
+        }
+        if (first_halted[c] == kNone) {
+          first_halted[c] = i;
+        }
+      }
+    });
+
+    if (accepted != kNone) {
+      SearchResult result = makeResult(RunStatus::HALTED, frontier[accepted], depth + 1);
+      result.configurations = num_visited;
+      return result;
+    }
+    if (out_of_memory) {
+      SearchResult result = makeResult(RunStatus::MEMORY_LIMIT, frontier[0], depth);
+      result.configurations = num_visited;
+      return result;
+    }
+    for (size_t c = 0; c < num_chunks; ++c) {
+      if (first_halted[c] != kNone) {
+        halted = frontier[first_halted[c]];
+        has_halted = true;
+        break;
+      }
+    }
+
+    // Deduplicación: cada fragmento de la tabla recorre los hijos en orden
+    std::vector<Node> next;
+    for (auto& block : children) {
+      std::move(block.begin(), block.end(), std::back_inserter(next));
+    }
+    children.clear();
+    std::vector<char> keep(next.size(), 0);
+    std::vector<size_t> first_repeat(num_shards, kNone);
+    std::vector<size_t> first_period(num_shards, 0);
+    parallelFor(num_shards, [&](size_t shard) {
+      for (size_t j = 0; j < next.size(); ++j) {
+        if (next[j].key.low % num_shards != shard) {
+          continue;
+        }
+        auto inserted = visited[shard].emplace(next[j].key, depth + 1);
+        keep[j] = inserted.second;
+        if (!inserted.second && first_repeat[shard] == kNone && inserted.first->second < depth + 1) {
+          first_repeat[shard] = j;
+          first_period[shard] = depth + 1 - inserted.first->second;
+        }
+      }
+    });
+    size_t repeat = kNone;
+    for (size_t shard = 0; shard < num_shards; ++shard) {
+      if (first_repeat[shard] < repeat) {
+        repeat = first_repeat[shard];
+        repeat_period = first_period[shard];
+      }
+    }
+    if (repeat != kNone) {
+      repeated = next[repeat];
+      has_repeated = true;
+    }
+
+    frontier.clear();
+    for (size_t j = 0; j < next.size(); ++j) {
+      if (keep[j]) {
+        frontier.push_back(std::move(next[j]));
+      }
+    }
+    frontier_bytes = 0;
+    for (const auto& node : frontier) {
+      frontier_bytes += nodeBytes(node);
+    }
+    num_visited += frontier.size();
+  }
+
+  SearchResult result = has_halted ? makeResult(RunStatus::HALTED, halted, halted.depth + 1)
+                                   : makeResult(RunStatus::NON_HALTING, repeated, repeated.depth);
+  if (!has_halted && has_repeated) {
+    result.cycle_period = repeat_period;
+  }
+  result.configurations = num_visited;
+  return result;
+}
+
+/**
+ * @brief Búsqueda en profundidad iterativa
+ *
+ * Cada ronda recorre en profundidad el árbol hasta un límite que empieza en 1 y se duplica hasta
+ * max_steps. Si hay varios hilos, los primeros niveles se expanden en anchura hasta tener unas
+ * 4 ramas por hilo, y cada rama es una tarea con su propia pila y su propia tabla de
+ * configuraciones (una configuración ya vista a la misma profundidad o menos se descarta). La
+ * rama aceptada es la primera en orden de recorrido, y las tareas de ramas posteriores a ella
+ * se abandonan. Una ronda en la que ninguna rama llega al límite ha recorrido todo el árbol.
+ */
+SearchResult NondeterministicSearch::iterativeDeepening(Node root, size_t max_steps) {
+  /**
+   * @brief Resultado del recorrido de un subárbol
+   */
+  struct Outcome {
+    bool accepted = false;
+    bool halted = false;
+    bool repeated = false;
+    bool cut = false;
+    bool memory = false;
+    Node accepted_node;
+    Node halted_node;
+    Node repeated_node;
+    size_t repeat_period = 0;
+    Node cut_node;
+    size_t visited = 0;
+  };
+
+  size_t limit = std::min<size_t>(1, max_steps);
+  size_t configurations = 0;
+  while (true) {
+    // Primeros niveles en anchura hasta tener trabajo para todos los hilos
+    std::vector<Node> seeds;
+    seeds.push_back(root);
+    Outcome prelude;
+    Visited prelude_visited;
+    prelude_visited.emplace(root.key, 0);
+    while (pool_ && !seeds.empty() && seeds.size() < 4 * jobs_ && seeds[0].depth < limit) {
+      std::vector<Node> next;
+      for (const auto& node : seeds) {
+        size_t before = next.size();
+        expand(node, next);
+        if (next.size() > before) {
+          // Las configuraciones repetidas no se reparten: su subárbol ya está en otra semilla
+          size_t kept = before;
+          for (size_t c = before; c < next.size(); ++c) {
+            auto inserted = prelude_visited.emplace(next[c].key, next[c].depth);
+            if (inserted.second) {
+              if (kept != c) {
+                next[kept] = std::move(next[c]);
+              }
+              ++kept;
+            } else if (!prelude.repeated && inserted.first->second < next[c].depth) {
+              prelude.repeated_node = next[c];
+              prelude.repeat_period = next[c].depth - inserted.first->second;
+              prelude.repeated = true;
+            }
+          }
+          next.resize(kept);
+          continue;
+        }
+        if (program_->isFinal(node.state)) {
+          SearchResult result = makeResult(RunStatus::HALTED, node, node.depth + 1);
+          result.configurations = configurations + seeds.size();
+          return result;
+        }
+        if (!prelude.halted || node.depth > prelude.halted_node.depth) {
+          prelude.halted_node = node;
+          prelude.halted = true;
+        }
+      }
+      seeds = std::move(next);
+      if (prelude_visited.size() * kVisitedEntryBytes > memory_limit_) {
+        SearchResult result = makeResult(RunStatus::MEMORY_LIMIT, seeds.empty() ? root : seeds[0], limit);
+        result.configurations = configurations + prelude_visited.size();
+        return result;
+      }
+    }
+    configurations += prelude_visited.size() - 1;
+
+    std::vector<Outcome> outcomes(seeds.size());
+    std::atomic<size_t> accepted(kNone);
+    std::atomic<size_t> used(0);
+    std::atomic<bool> out_of_memory(false);
+    auto explore = [&](size_t s) {
+      Outcome& out = outcomes[s];
+      Visited visited;
+      std::vector<Node> stack;
+      std::vector<Node> children;
+      const size_t stack_bytes = sizeof(Node) + num_tapes_ * sizeof(TapeView);
+      stack.push_back(seeds[s]);
+      used += stack_bytes;
+      while (!stack.empty() && s < accepted.load(std::memory_order_relaxed)) {
+        if (out_of_memory) {
+          out.memory = true;
+          break;
+        }
+        Node node = std::move(stack.back());
+        stack.pop_back();
+        used -= stack_bytes;
+
+        auto inserted = visited.emplace(node.key, node.depth);
+        if (!inserted.second) {
+          if (inserted.first->second <= node.depth) {
+            if (!out.repeated && inserted.first->second < node.depth) {
+              out.repeated_node = node;
+              out.repeat_period = node.depth - inserted.first->second;
+              out.repeated = true;
+            }
+            continue;
+          }
+          inserted.first->second = node.depth;
+        } else if ((used += kVisitedEntryBytes) > memory_limit_) {
+          out_of_memory = true;
+        }
+
+        if (node.depth >= limit) {
+          if (!out.cut) {
+            out.cut_node = node;
+            out.cut = true;
+          }
+          continue;
+        }
+        children.clear();
+        expand(node, children);
+        if (children.empty()) {
+          if (program_->isFinal(node.state)) {
+            out.accepted_node = std::move(node);
+            out.accepted = true;
+            storeMin(accepted, s);
+            break;
+          }
+          if (!out.halted || node.depth > out.halted_node.depth) {
+            out.halted_node = node;
+            out.halted = true;
+          }
+          continue;
+        }
+        // Se apilan en orden inverso para recorrer las transiciones en orden de definición
+        for (auto child = children.rbegin(); child != children.rend(); ++child) {
+          stack.push_back(std::move(*child));
+          used += stack_bytes;
+        }
+      }
+      used -= stack.size() * stack_bytes;
+      out.visited = visited.size();
+      used -= visited.size() * kVisitedEntryBytes;
+    };
+    if (pool_ && seeds.size() > 1) {
+      for (size_t s = 0; s < seeds.size(); ++s) {
+        pool_->submit([&explore, s](size_t) { explore(s); });
+      }
+      pool_->wait();
+    } else {
+      for (size_t s = 0; s < seeds.size(); ++s) {
+        explore(s);
+      }
+    }
+
+    for (const auto& out : outcomes) {
+      configurations += out.visited;
+    }
+    if (accepted != kNone) {
+      const Node& node = outcomes[accepted].accepted_node;
+      SearchResult result = makeResult(RunStatus::HALTED, node, node.depth + 1);
+      result.configurations = configurations;
+      return result;
+    }
+
+    const Outcome* halted = prelude.halted ? &prelude : nullptr;
+    const Outcome* repeated = prelude.repeated ? &prelude : nullptr;
+    const Outcome* cut = nullptr;
+    for (const auto& out : outcomes) {
+      if (out.memory) {
+        SearchResult result = makeResult(RunStatus::MEMORY_LIMIT, out.cut ? out.cut_node : root, limit);
+        result.configurations = configurations;
+        return result;
+      }
+      if (out.halted && (halted == nullptr || out.halted_node.depth > halted->halted_node.depth)) {
+        halted = &out;
+      }
+      if (out.repeated && repeated == nullptr) {
+        repeated = &out;
+      }
+      if (out.cut && cut == nullptr) {
+        cut = &out;
+      }
+    }
+
+    if (cut == nullptr || seeds.empty()) {
+      SearchResult result;
+      if (halted != nullptr) {
+        result = makeResult(RunStatus::HALTED, halted->halted_node, halted->halted_node.depth + 1);
+      } else if (repeated != nullptr) {
+        result = makeResult(RunStatus::NON_HALTING, repeated->repeated_node, repeated->repeated_node.depth);
+        result.cycle_period = repeated->repeat_period;
+      } else {
+        result = makeResult(RunStatus::NON_HALTING, root, 0);
+      }
+      result.configurations = configurations;
+      return result;
+    }
+    if (limit >= max_steps) {
+      SearchResult result = makeResult(RunStatus::STEP_LIMIT, cut->cut_node, max_steps);
+      result.configurations = configurations;
+      return result;
+    }
+    limit = limit > max_steps / 2 ? max_steps : 2 * limit;
+  }
+}
+
+/**
+ * @brief Configuración inicial: la entrada en la primera cinta y el resto vacías (como Tape::reset)
+ */
+NondeterministicSearch::Node NondeterministicSearch::makeRoot(std::string_view input) const {
+  Node root;
+  root.state = program_->getInitialState();
+  root.depth = 0;
+  root.key = stateKey(root.state);
+  for (size_t t = 0; t < num_tapes_; ++t) {
+    std::string cells(1, blank_symbol_);
+    if (t == 0 && !input.empty()) {
+      cells.append(input.data(), input.size());
+    } else {
+      cells += blank_symbol_;
+    }
+    cells += blank_symbol_;
+    for (size_t i = 0; i < cells.size(); ++i) {
+      if (cells[i] != blank_symbol_) {
+        toggle(root.key, cellKey(t, static_cast<long>(i), cells[i]));
+      }
+    }
+    toggle(root.key, headKey(t, 1));
+    long size = static_cast<long>(cells.size());
+    root.tapes.push_back(TapeView{std::make_shared<const std::string>(std::move(cells)), 0, 0, size, 1});
+  }
+  return root;
+}
+
+/**
+ * @brief Añade a children una configuración por cada transición aplicable a node
+ * @param node Configuración de partida
+ * @param children Vector al que se añaden los hijos, en orden de definición de las transiciones
+ *
+ * Las escrituras, los movimientos y la extensión de las cintas siguen exactamente a Tape::write,
+ * Tape::moveLeft y Tape::moveRight.
+ */
+void NondeterministicSearch::expand(const Node& node, std::vector<Node>& children) const {
+  char symbols[256];
+  std::vector<char> wide;
+  char* read_symbols = symbols;
+  if (num_tapes_ > sizeof(symbols)) {
+    wide.resize(num_tapes_);
+    read_symbols = wide.data();
+  }
+  for (size_t t = 0; t < num_tapes_; ++t) {
+    read_symbols[t] = read(node.tapes[t], blank_symbol_);
+  }
+
+  for (int32_t transition = program_->findTransition(node.state, read_symbols);
+       transition != TransitionTable::kNoTransition; transition = program_->getAlternative(transition)) {
+    Node child;
+    child.state = program_->getNextState(transition);
+    child.depth = node.depth + 1;
+    child.key = node.key;
+    toggle(child.key, stateKey(node.state));
+    toggle(child.key, stateKey(child.state));
+    child.tapes = node.tapes;
+
+    for (size_t t = 0; t < num_tapes_; ++t) {
+      TapeView& tape = child.tapes[t];
+      char old_symbol = read_symbols[t];
+      char symbol = program_->getWriteSymbol(transition, t, old_symbol);
+      if (symbol != old_symbol) {
+        // Copia en escritura: las celdas nuevas cubren también la del cabezal
+        long size = static_cast<long>(tape.cells->size());
+        long low = std::min(tape.base, tape.head);
+        long high = std::max(tape.base + size, tape.head + 1);
+        auto cells = std::make_shared<std::string>(static_cast<size_t>(high - low), blank_symbol_);
+        std::copy(tape.cells->begin(), tape.cells->end(), cells->begin() + (tape.base - low));
+        (*cells)[static_cast<size_t>(tape.head - low)] = symbol;
+        tape.cells = std::move(cells);
+        tape.base = low;
+        if (old_symbol != blank_symbol_) {
+          toggle(child.key, cellKey(t, tape.head, old_symbol));
+        }
+        if (symbol != blank_symbol_) {
+          toggle(child.key, cellKey(t, tape.head, symbol));
+        }
+      }
+      if (symbol != blank_symbol_) {
+        if (tape.head == tape.begin) {
+          tape.begin--;
+        }
+        if (tape.head == tape.end - 1) {
+          tape.end++;
+        }
+      }
+
+      Movement movement = program_->getMovement(transition, t);
+      if (movement == Movement::STAY) {
+        continue;
+      }
+      toggle(child.key, headKey(t, tape.head));
+      if (movement == Movement::LEFT) {
+        if (tape.head == tape.begin) {
+          tape.begin--;
+        }
+        tape.head--;
+      } else {
+        if (tape.head == tape.end - 1) {
+          tape.end++;
+        }
+        tape.head++;
+      }
+      toggle(child.key, headKey(t, tape.head));
+    }
+    children.push_back(std::move(child));
+  }
+}
+
+/**
+ * @brief Memoria estimada de una configuración (las celdas compartidas se reparten entre sus ramas)
+ */
+size_t NondeterministicSearch::nodeBytes(const Node& node) const {
+  size_t bytes = sizeof(Node) + num_tapes_ * sizeof(TapeView);
+  for (const auto& tape : node.tapes) {
+    bytes += (kCellsBytes + tape.cells->size()) / static_cast<size_t>(std::max<long>(1, tape.cells.use_count()));
+  }
+  return bytes;
+}
+
+/**
+ * @brief Convierte una configuración en el resultado de la búsqueda
+ */
+SearchResult NondeterministicSearch::makeResult(RunStatus status, const Node& node, size_t steps) const {
+  SearchResult result;
+  result.status = status;
+  result.state = node.state;
+  result.steps = steps;
+  for (const auto& tape : node.tapes) {
+    std::string content(static_cast<size_t>(tape.end - tape.begin), blank_symbol_);
+    for (long position = tape.begin; position < tape.end; ++position) {
+      long index = position - tape.base;
+      if (index >= 0 && index < static_cast<long>(tape.cells->size())) {
+        content[static_cast<size_t>(position - tape.begin)] = (*tape.cells)[static_cast<size_t>(index)];
+      }
+    }
+    result.tapes.push_back(std::move(content));
+    result.heads.push_back(static_cast<int>(tape.head - tape.begin));
+  }
+  return result;
+}
+
+/**
+ * @brief Símbolo bajo el cabezal de una cinta (blanco fuera de sus celdas)
+ */
+char NondeterministicSearch::read(const TapeView& tape, char blank_symbol) {
+  long index = tape.head - tape.base;
+  if (index < 0 || index >= static_cast<long>(tape.cells->size())) {
+    return blank_symbol;
+  }
+  return (*tape.cells)[static_cast<size_t>(index)];
+}
+
+/**
+ * @brief Mezclador de bits (splitmix64)
+ */
+uint64_t NondeterministicSearch::mix(uint64_t value) {
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+/**
+ * @brief Término del hash para una celda no blanca
+ */
+NondeterministicSearch::Key NondeterministicSearch::cellKey(size_t tape, long position, char symbol) {
+  uint64_t value = (static_cast<uint64_t>(position) << 16) ^ (static_cast<uint64_t>(tape) << 8) ^
+                   static_cast<unsigned char>(symbol);
+  return Key{mix(value ^ 0x1000000000000000ULL), mix(value ^ 0x2000000000000000ULL)};
+}
+
+/**
+ * @brief Término del hash para la posición de un cabezal
+ */
+NondeterministicSearch::Key NondeterministicSearch::headKey(size_t tape, long position) {
+  uint64_t value = (static_cast<uint64_t>(position) << 16) ^ static_cast<uint64_t>(tape);
+  return Key{mix(value ^ 0x3000000000000000ULL), mix(value ^ 0x4000000000000000ULL)};
+}
+
+/**
+ * @brief Término del hash para el estado
+ */
+NondeterministicSearch::Key NondeterministicSearch::stateKey(uint32_t state) {
+  return Key{mix(state ^ 0x5000000000000000ULL), mix(state ^ 0x6000000000000000ULL)};
+}
+
+/**
+ * @brief Añade o quita un término del hash
+ */
+void NondeterministicSearch::toggle(Key& key, const Key& term) {
+  key.low ^= term.low;
+  key.high ^= term.high;
+}
@@ -0,0 +1,455 @@
+#include "../include/PackedTape.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Constructor (cinta vacía)
+ * @param blank_symbol Símbolo blanco de la cinta (código 0)
+ * @param tape_alphabet Símbolos que puede contener la cinta
+ *
+ * El ancho de celda se elige a partir del número de símbolos (el blanco incluido).
+ */
+PackedTape::PackedTape(char blank_symbol, const Alphabet& tape_alphabet)
+  : blank_symbol_(blank_symbol), begin_(0), end_(0), head_(0), origin_(0) {
+  std::fill(std::begin(code_of_), std::end(code_of_), kNoCode);
+  std::fill(std::begin(symbol_of_), std::end(symbol_of_), blank_symbol);
+  size_t num_symbols = 0;
+  code_of_[static_cast<unsigned char>(blank_symbol)] = 0;
+  symbol_of_[num_symbols++] = blank_symbol;
+  for (char symbol : tape_alphabet.getSymbols()) {
+    if (code_of_[static_cast<unsigned char>(symbol)] == kNoCode) {
+      code_of_[static_cast<unsigned char>(symbol)] = static_cast<uint8_t>(num_symbols);
+      symbol_of_[num_symbols++] = symbol;
+    }
+  }
+
+  bits_ = num_symbols <= 2 ? 1 : num_symbols <= 4 ? 2 : num_symbols <= 16 ? 4 : 8;
+  cell_shift_ = 0;
+  while ((1u << cell_shift_) * bits_ < 64) {
+    cell_shift_++;
+  }
+  cell_mask_ = (uint64_t(1) << bits_) - 1;
+  low_bits_ = ~uint64_t(0) / cell_mask_;
+
+  words_.assign(kInitialWords, 0);
+  origin_ = capacity() / 2;
+  begin_ = end_ = head_ = origin_;
+  reset("");
+}
+
+/**
+ * @brief Crea una copia de la cinta
+ * @return Copia independiente
+ */
+std::unique_ptr<TapeBackend> PackedTape::clone() const {
+  return std::make_unique<PackedTape>(*this);
+}
+
+/**
+ * @brief Obtiene el tipo de almacenamiento
+ * @return TapeStorage::PACKED
+ */
+TapeStorage PackedTape::getStorage() const {
+  return TapeStorage::PACKED;
+}
+
+/**
+ * @brief Lee el símbolo en la posición actual del cabezal
+ * @return Símbolo leído
+ */
+char PackedTape::read() const {
+  return symbol_of_[getCode(head_)];
+}
+
+/**
+ * @brief Escribe un símbolo en la posición actual del cabezal
+ * @param symbol Símbolo a escribir
+ * @throws std::invalid_argument si el símbolo no pertenece al alfabeto de la cinta
+ */
+void PackedTape::write(char symbol) {
+  setCode(head_, encode(symbol));
+
+  if (symbol != blank_symbol_) {
+    if (head_ == begin_) {
+      expandLeft();
+    }
+    if (head_ == end_ - 1) {
+      expandRight();
+    }
+  }
+}
+
+/**
+ * @brief Mueve el cabezal a la izquierda, expandiendo la cinta si es necesario
+ */
+void PackedTape::moveLeft() {
+  if (head_ == begin_) {
+    expandLeft();
+  }
+  head_--;
+}
+
+/**
+ * @brief Mueve el cabezal a la derecha, expandiendo la cinta si es necesario
+ */
+void PackedTape::moveRight() {
+  if (head_ == end_ - 1) {
+    expandRight();
+  }
+  head_++;
+}
+
+/**
+ * @brief Mueve el cabezal a la izquierda mientras lea símbolos del conjunto
+ * @param symbols Símbolos que se atraviesan
+ * @param limit Número máximo de movimientos
+ * @return Número de movimientos realizados
+ *
+ * Las celdas de cada palabra se comparan a la vez con los códigos del conjunto (ver spanBackward).
+ */
+size_t PackedTape::scanLeft(const SymbolSet& symbols, size_t limit) {
+  uint64_t patterns[256];
+  size_t count_patterns = buildPatterns(symbols, patterns);
+
+  size_t moved = 0;
+  while (moved < limit) {
+    if (head_ == 0) {
+      growLeft();
+    }
+    size_t span = std::min(limit - moved, head_);
+    size_t count = spanBackward(head_, span, patterns, count_patterns);
+    head_ -= count;
+    moved += count;
+    if (count < span) {
+      break;
+    }
+  }
+  begin_ = std::min(begin_, head_);
+  return moved;
+}
+
+/**
+ * @brief Mueve el cabezal a la derecha mientras lea símbolos del conjunto
+ * @param symbols Símbolos que se atraviesan
+ * @param limit Número máximo de movimientos
+ * @return Número de movimientos realizados
+ */
+size_t PackedTape::scanRight(const SymbolSet& symbols, size_t limit) {
+  uint64_t patterns[256];
+  size_t count_patterns = buildPatterns(symbols, patterns);
+
+  size_t moved = 0;
+  while (moved < limit) {
+    if (head_ == capacity() - 1) {
+      growRight();
+    }
+    size_t span = std::min(limit - moved, capacity() - 1 - head_);
+    size_t count = spanForward(head_, span, patterns, count_patterns);
+    head_ += count;
+    moved += count;
+    if (count < span) {
+      break;
+    }
+  }
+  end_ = std::max(end_, head_ + 1);
+  return moved;
+}
+
+/**
+ * @brief Obtiene la posición del cabezal
+ * @return Posición del cabezal dentro de la cinta
+ */
+int PackedTape::getHeadPosition() const {
+  return static_cast<int>(head_ - begin_);
+}
+
+/**
+ * @brief Obtiene el número de celdas de la cinta
+ * @return Número de celdas (incluidos los blancos de los extremos)
+ */
+size_t PackedTape::getSize() const {
+  return end_ - begin_;
+}
+
+/**
+ * @brief Obtiene el contenido de la cinta
+ * @return Contenido de la cinta
+ */
+std::string PackedTape::getContent() const {
+  return decode(begin_, end_);
+}
+
+/**
+ * @brief Obtiene el contenido de la cinta con la posición del cabezal marcada
+ * @return String en formato "ab[c]de"
+ */
+std::string PackedTape::getContentWithHead() const {
+  return decode(begin_, head_) + '[' + read() + ']' + decode(head_ + 1, end_);
+}
+
+/**
+ * @brief Obtiene las celdas [first, last) de la cinta
+ * @param first Primera celda (posición dentro de la cinta)
+ * @param last Celda siguiente a la última
+ * @return Contenido de esas celdas
+ */
+std::string PackedTape::getRange(size_t first, size_t last) const {
+  return decode(begin_ + first, begin_ + last);
+}
+
+/**
+ * @brief Obtiene el contenido de la cinta sin los blancos de los extremos
+ * @return Contenido entre la primera y la última celda no blanca (vacío si todo es blanco)
+ *
+ * Fuera de [begin_, end_) todas las celdas son blancas (código 0), así que basta con buscar la
+ * primera y la última palabra distinta de cero.
+ */
+std::string PackedTape::getTrimmedContent() const {
+  size_t first_word = begin_ >> cell_shift_;
+  size_t last_word = (end_ - 1) >> cell_shift_;
+  while (first_word <= last_word && words_[first_word] == 0) {
+    first_word++;
+  }
+  if (first_word > last_word) {
+    return "";
+  }
+  while (words_[last_word] == 0) {
+    last_word--;
+  }
+
+  size_t first = (first_word << cell_shift_) + static_cast<size_t>(__builtin_ctzll(words_[first_word])) / bits_;
+  size_t last = (last_word << cell_shift_) + static_cast<size_t>(63 - __builtin_clzll(words_[last_word])) / bits_;
+  return decode(first, last + 1);
+}
+
+/**
+ * @brief Reinicia la cinta con una nueva cadena de entrada
+ * @param input Nueva cadena de entrada
+ * @throws std::invalid_argument si la entrada contiene símbolos fuera del alfabeto de la cinta
+ *
+ * Conserva la capacidad del buffer y pone a cero solo las palabras usadas en la ejecución anterior.
+ */
+void PackedTape::reset(std::string_view input) {
+  for (char symbol : input) {
+    encode(symbol);
+  }
+
+  clear(begin_, end_);
+  size_t length = std::max<size_t>(input.size(), 1) + 2;
+  while (origin_ + length > capacity()) {
+    growRight();
+  }
+
+  begin_ = origin_;
+  end_ = begin_ + length;
+  head_ = begin_ + 1;
+  for (size_t i = 0; i < input.size(); ++i) {
+    setCode(head_ + i, code_of_[static_cast<unsigned char>(input[i])]);
+  }
+}
+
+/**
+ * @brief Carga una configuración exacta de la cinta
+ * @param content Contenido completo de la cinta
+ * @param head_position Posición del cabezal dentro de content
+ * @throws std::invalid_argument si el cabezal queda fuera del contenido o hay símbolos fuera del alfabeto
+ */
+void PackedTape::load(const std::string& content, int head_position) {
+  if (head_position < 0 || static_cast<size_t>(head_position) >= content.size()) {
+    throw std::invalid_argument("La posición del cabezal debe estar dentro de la cinta");
+  }
+  for (char symbol : content) {
+    encode(symbol);
+  }
+
+  clear(begin_, end_);
+  while (origin_ + content.size() > capacity()) {
+    growRight();
+  }
+
+  begin_ = origin_;
+  end_ = begin_ + content.size();
+  head_ = begin_ + head_position;
+  for (size_t i = 0; i < content.size(); ++i) {
+    setCode(begin_ + i, code_of_[static_cast<unsigned char>(content[i])]);
+  }
+}
+
+/**
+ * @brief Obtiene el ancho de celda elegido
+ * @return Bits por celda (1, 2, 4 u 8)
+ */
+unsigned PackedTape::getBitsPerCell() const {
+  return bits_;
+}
+
+uint8_t PackedTape::getCode(size_t cell) const {
+  unsigned shift = static_cast<unsigned>(cell & ((size_t(1) << cell_shift_) - 1)) * bits_;
+  return static_cast<uint8_t>((words_[cell >> cell_shift_] >> shift) & cell_mask_);
+}
+
+void PackedTape::setCode(size_t cell, uint8_t code) {
+  unsigned shift = static_cast<unsigned>(cell & ((size_t(1) << cell_shift_) - 1)) * bits_;
+  uint64_t& word = words_[cell >> cell_shift_];
+  word = (word & ~(cell_mask_ << shift)) | (uint64_t(code) << shift);
+}
+
+/**
+ * @brief Código de un símbolo
+ * @throws std::invalid_argument si el símbolo no pertenece al alfabeto de la cinta
+ */
+uint8_t PackedTape::encode(char symbol) const {
+  uint8_t code = code_of_[static_cast<unsigned char>(symbol)];
+  if (code == kNoCode) {
+    throw std::invalid_argument(std::string("El símbolo '") + symbol + "' no pertenece al alfabeto de la cinta");
+  }
+  return code;
+}
+
+/**
+ * @brief Marca las celdas de una palabra cuyo código está entre los patrones
+ * @param word Palabra de la cinta
+ * @param patterns Códigos del conjunto, cada uno repetido en todas las celdas de una palabra
+ * @param count Número de patrones
+ * @return Palabra con el bit menos significativo de cada celda a 1 si la celda pertenece al conjunto
+ *
+ * Una celda coincide con un patrón si todos sus bits son iguales: tras negar el XOR, los bits de
+ * cada celda se combinan con AND en su bit menos significativo.
+ */
+uint64_t PackedTape::matchMask(uint64_t word, const uint64_t* patterns, size_t count) const {
+  uint64_t match = 0;
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t equal = ~(word ^ patterns[i]);
+    for (unsigned shift = 1; shift < bits_; shift <<= 1) {
+      equal &= equal >> shift;
+    }
+    match |= equal;
+  }
+  return match & low_bits_;
+}
+
+/**
+ * @brief Patrones de los códigos de un conjunto de símbolos (los que no están en la cinta se ignoran)
+ * @return Número de patrones
+ */
+size_t PackedTape::buildPatterns(const SymbolSet& symbols, uint64_t* patterns) const {
+  size_t count = 0;
+  for (uint64_t code = 0; code <= cell_mask_; ++code) {
+    char symbol = symbol_of_[code];
+    if (code_of_[static_cast<unsigned char>(symbol)] == code && symbols.contains(symbol)) {
+      patterns[count++] = code * low_bits_;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Cuenta las celdas consecutivas del conjunto hacia la derecha
+ * @param cell Primera celda
+ * @param count Número máximo de celdas a examinar
+ * @return Número de celdas iniciales que pertenecen al conjunto
+ */
+size_t PackedTape::spanForward(size_t cell, size_t count, const uint64_t* patterns, size_t count_patterns) const {
+  size_t cells_per_word = size_t(1) << cell_shift_;
+  size_t i = 0;
+  while (i < count) {
+    size_t current = cell + i;
+    size_t offset = current & (cells_per_word - 1);
+    uint64_t outside = ~matchMask(words_[current >> cell_shift_], patterns, count_patterns) & low_bits_;
+    outside >>= offset * bits_;
+    if (outside != 0) {
+      return std::min(count, i + static_cast<size_t>(__builtin_ctzll(outside)) / bits_);
+    }
+    i += cells_per_word - offset;
+  }
+  return count;
+}
+
+/**
+ * @brief Cuenta las celdas consecutivas del conjunto hacia la izquierda
+ * @param cell Primera celda
+ * @param count Número máximo de celdas a examinar (cell .. cell - count + 1)
+ * @return Número de celdas iniciales que pertenecen al conjunto
+ */
+size_t PackedTape::spanBackward(size_t cell, size_t count, const uint64_t* patterns, size_t count_patterns) const {
+  size_t cells_per_word = size_t(1) << cell_shift_;
+  size_t i = 0;
+  while (i < count) {
+    size_t current = cell - i;
+    size_t offset = current & (cells_per_word - 1);
+    uint64_t outside = ~matchMask(words_[current >> cell_shift_], patterns, count_patterns) & low_bits_;
+    outside <<= (cells_per_word - 1 - offset) * bits_;
+    if (outside != 0) {
+      size_t top = static_cast<size_t>(63 - __builtin_clzll(outside)) / bits_;
+      return std::min(count, i + (cells_per_word - 1 - top));
+    }
+    i += offset + 1;
+  }
+  return count;
+}
+
+/**
+ * @brief Decodifica las celdas [from, to)
+ */
+std::string PackedTape::decode(size_t from, size_t to) const {
+  std::string content;
+  content.reserve(to > from ? to - from : 0);
+  for (size_t cell = from; cell < to; ++cell) {
+    content += symbol_of_[getCode(cell)];
+  }
+  return content;
+}
+
+/**
+ * @brief Pone en blanco las celdas [from, to), palabra a palabra salvo en los extremos
+ */
+void PackedTape::clear(size_t from, size_t to) {
+  size_t cells_per_word = size_t(1) << cell_shift_;
+  while (from < to && (from & (cells_per_word - 1)) != 0) {
+    setCode(from++, 0);
+  }
+  while (to > from && (to & (cells_per_word - 1)) != 0) {
+    setCode(--to, 0);
+  }
+  std::fill(words_.begin() + (from >> cell_shift_), words_.begin() + (to >> cell_shift_), 0);
+}
+
+/**
+ * @brief Añade un blanco al inicio de la cinta (las celdas de fuera ya son blancos)
+ */
+void PackedTape::expandLeft() {
+  if (begin_ == 0) {
+    growLeft();
+  }
+  begin_--;
+}
+
+/**
+ * @brief Añade un blanco al final de la cinta
+ */
+void PackedTape::expandRight() {
+  if (end_ == capacity()) {
+    growRight();
+  }
+  end_++;
+}
+
+/**
+ * @brief Duplica la capacidad añadiendo palabras en blanco a la izquierda
+ */
+void PackedTape::growLeft() {
+  size_t added = words_.size();
+  words_.insert(words_.begin(), added, 0);
+  size_t cells = added << cell_shift_;
+  begin_ += cells;
+  end_ += cells;
+  head_ += cells;
+  origin_ += cells;
+}
+
+/**
+ * @brief Duplica la capacidad añadiendo palabras en blanco a la derecha
+ */
+void PackedTape::growRight() {
+  words_.resize(words_.size() * 2, 0);
+}
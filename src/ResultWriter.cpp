@@ -0,0 +1,372 @@
+#include "../include/ResultWriter.hpp"
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief Nombre de los campos en la cabecera CSV/TSV y en las claves JSON
+ */
+const char* kFieldNames[] = {"index", "input", "status", "accepted", "steps", "state", "result", "tapes"};
+
+const char* statusName(RunStatus status) {
+  switch (status) {
+    case RunStatus::HALTED:
+      return "halted";
+    case RunStatus::STEP_LIMIT:
+      return "step_limit";
+    case RunStatus::NON_HALTING:
+      return "non_halting";
+    case RunStatus::MEMORY_LIMIT:
+      return "memory_limit";
+  }
+  return "";
+}
+
+}  // namespace
+
+/**
+ * @brief Crea el escritor
+ * @param format Formato de salida
+ * @param fields Campos a escribir (combinación de Field; se ignora con OutputFormat::TEXT)
+ * @param num_tapes Número de cintas de la máquina (una columna por cinta en CSV/TSV)
+ *
+ * En CSV y TSV escribe la cabecera con el nombre de las columnas.
+ */
+ResultWriter::ResultWriter(OutputFormat format, unsigned fields, size_t num_tapes)
+  : format_(format), fields_(format == OutputFormat::TEXT ? kAllFields : fields), num_tapes_(num_tapes) {
+  buffer_.reserve(kBufferSize + kBufferSize / 4);
+  if (format_ == OutputFormat::CSV) {
+    writeHeader(',');
+  } else if (format_ == OutputFormat::TSV) {
+    writeHeader('\t');
+  }
+}
+
+/**
+ * @brief Vuelca lo pendiente
+ */
+ResultWriter::~ResultWriter() {
+  flush();
+}
+
+/**
+ * @brief Convierte el valor de --fields en la combinación de campos
+ * @param list Nombres de los campos separados por comas
+ * @param fields Campos resultantes
+ * @return true si todos los nombres son válidos
+ */
+bool ResultWriter::parseFields(const std::string& list, unsigned& fields) {
+  fields = 0;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t comma = list.find(',', start);
+    if (comma == std::string::npos) {
+      comma = list.size();
+    }
+    std::string name = list.substr(start, comma - start);
+    unsigned field = 0;
+    for (size_t i = 0; i < sizeof(kFieldNames) / sizeof(kFieldNames[0]); ++i) {
+      if (name == kFieldNames[i]) {
+        field = 1u << i;
+      }
+    }
+    if (field == 0) {
+      return false;
+    }
+    fields |= field;
+    start = comma + 1;
+  }
+  return true;
+}
+
+/**
+ * @brief Escribe el resultado de una cadena
+ * @param index Posición de la cadena en la entrada (desde 0)
+ * @param input Cadena de entrada
+ * @param result Resultado de la ejecución
+ * @return false si la ejecución terminó con error (se notifica en stderr tras volcar lo pendiente)
+ */
+bool ResultWriter::write(size_t index, std::string_view input, const RunResult& result) {
+  if (format_ == OutputFormat::TEXT) {
+    writeText(index, input, result);
+  } else if (result.error.empty()) {
+    switch (format_) {
+      case OutputFormat::JSONL:
+        writeJson(index, input, result);
+        break;
+      case OutputFormat::CSV:
+        writeDelimited(index, input, result, ',');
+        break;
+      case OutputFormat::TSV:
+        writeDelimited(index, input, result, '\t');
+        break;
+      case OutputFormat::TEXT:
+        break;
+    }
+  }
+
+  if (!result.error.empty()) {
+    flush();
+    std::cerr << "Error: " << result.error << "\n";
+    return false;
+  }
+  if (buffer_.size() >= kBufferSize) {
+    flush();
+  }
+  return true;
+}
+
+/**
+ * @brief Vuelca el buffer a la salida estándar
+ */
+void ResultWriter::flush() {
+  if (!buffer_.empty()) {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), stdout);
+    buffer_.clear();
+  }
+  std::fflush(stdout);
+}
+
+/**
+ * @brief Indica si hay que obtener las cintas completas de cada ejecución
+ */
+bool ResultWriter::wantsTapes() const {
+  return fields_ & TAPES;
+}
+
+/**
+ * @brief Indica si hay que obtener el resultado de la primera cinta de cada ejecución
+ */
+bool ResultWriter::wantsResult() const {
+  return fields_ & RESULT;
+}
+
+/**
+ * @brief Formato de texto decorado (cabecera de la cadena, veredicto, estado, pasos y cintas)
+ */
+void ResultWriter::writeText(size_t index, std::string_view input, const RunResult& result) {
+  buffer_ += "---------------------------------------------------\n";
+  buffer_ += "Cadena de entrada #";
+  buffer_ += std::to_string(index + 1);
+  buffer_ += ": \"";
+  buffer_ += input;
+  buffer_ += "\"\n";
+  buffer_ += "---------------------------------------------------\n\n";
+  if (!result.error.empty()) {
+    return;
+  }
+
+  if (result.status == RunStatus::STEP_LIMIT) {
+    buffer_ += "La máquina excedió el número máximo de pasos\n\n";
+  } else if (result.status == RunStatus::NON_HALTING) {
+    buffer_ += "La máquina no se detiene: repite una configuración cada ";
+    buffer_ += std::to_string(result.cycle_period);
+    buffer_ += " pasos\n\n";
+  } else if (result.status == RunStatus::MEMORY_LIMIT) {
+    buffer_ += "La búsqueda excedió el límite de memoria\n\n";
+  }
+
+  buffer_ += "Resultado: ";
+  buffer_ += result.accepted ? "ACEPTADA" : "RECHAZADA";
+  buffer_ += "\nEstado final: ";
+  buffer_ += result.final_state;
+  buffer_ += "\nPasos ejecutados: ";
+  buffer_ += std::to_string(result.steps);
+  buffer_ += "\n\n";
+
+  for (size_t j = 0; j < result.tapes.size(); ++j) {
+    buffer_ += "Cinta ";
+    buffer_ += std::to_string(j + 1);
+    buffer_ += ": ";
+    buffer_ += result.tapes[j];
+    buffer_ += "\n";
+  }
+  buffer_ += "\n";
+}
+
+/**
+ * @brief Formato JSONL: {"index": 1, "input": "...", ..., "tapes": ["...", ...]}
+ */
+void ResultWriter::writeJson(size_t index, std::string_view input, const RunResult& result) {
+  const char* separator = "{";
+  auto key = [&](const char* name) {
+    buffer_ += separator;
+    buffer_ += '"';
+    buffer_ += name;
+    buffer_ += "\":";
+    separator = ",";
+  };
+
+  if (fields_ & INDEX) {
+    key("index");
+    buffer_ += std::to_string(index + 1);
+  }
+  if (fields_ & INPUT) {
+    key("input");
+    appendJsonString(input);
+  }
+  if (fields_ & STATUS) {
+    key("status");
+    appendJsonString(statusName(result.status));
+  }
+  if (fields_ & ACCEPTED) {
+    key("accepted");
+    buffer_ += result.accepted ? "true" : "false";
+  }
+  if (fields_ & STEPS) {
+    key("steps");
+    buffer_ += std::to_string(result.steps);
+  }
+  if (fields_ & STATE) {
+    key("state");
+    appendJsonString(result.final_state);
+  }
+  if (fields_ & RESULT) {
+    key("result");
+    appendJsonString(result.result);
+  }
+  if (fields_ & TAPES) {
+    key("tapes");
+    buffer_ += '[';
+    for (size_t j = 0; j < result.tapes.size(); ++j) {
+      if (j > 0) {
+        buffer_ += ',';
+      }
+      appendJsonString(result.tapes[j]);
+    }
+    buffer_ += ']';
+  }
+  buffer_ += fields_ == 0 ? "{}\n" : "}\n";
+}
+
+/**
+ * @brief Formatos CSV y TSV: una fila por cadena con los campos elegidos (una columna por cinta)
+ */
+void ResultWriter::writeDelimited(size_t index, std::string_view input, const RunResult& result, char separator) {
+  bool first = true;
+  auto next = [&]() {
+    if (!first) {
+      buffer_ += separator;
+    }
+    first = false;
+  };
+
+  if (fields_ & INDEX) {
+    next();
+    buffer_ += std::to_string(index + 1);
+  }
+  if (fields_ & INPUT) {
+    next();
+    appendField(input, separator);
+  }
+  if (fields_ & STATUS) {
+    next();
+    buffer_ += statusName(result.status);
+  }
+  if (fields_ & ACCEPTED) {
+    next();
+    buffer_ += result.accepted ? "true" : "false";
+  }
+  if (fields_ & STEPS) {
+    next();
+    buffer_ += std::to_string(result.steps);
+  }
+  if (fields_ & STATE) {
+    next();
+    appendField(result.final_state, separator);
+  }
+  if (fields_ & RESULT) {
+    next();
+    appendField(result.result, separator);
+  }
+  if (fields_ & TAPES) {
+    for (size_t j = 0; j < num_tapes_; ++j) {
+      next();
+      appendField(j < result.tapes.size() ? result.tapes[j] : "", separator);
+    }
+  }
+  buffer_ += '\n';
+}
+
+/**
+ * @brief Cabecera de CSV/TSV (las cintas se llaman tape1, tape2, ...)
+ */
+void ResultWriter::writeHeader(char separator) {
+  bool first = true;
+  for (size_t i = 0; i < sizeof(kFieldNames) / sizeof(kFieldNames[0]); ++i) {
+    if (!(fields_ & (1u << i))) {
+      continue;
+    }
+    size_t columns = (1u << i) == TAPES ? num_tapes_ : 1;
+    for (size_t j = 0; j < columns; ++j) {
+      if (!first) {
+        buffer_ += separator;
+      }
+      first = false;
+      buffer_ += (1u << i) == TAPES ? "tape" + std::to_string(j + 1) : kFieldNames[i];
+    }
+  }
+  buffer_ += '\n';
+}
+
+/**
+ * @brief Añade un texto entre comillas con el escapado de JSON
+ */
+void ResultWriter::appendJsonString(std::string_view text) {
+  buffer_ += '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      buffer_ += '\\';
+      buffer_ += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      const char* hex = "0123456789abcdef";
+      buffer_ += "\\u00";
+      buffer_ += hex[(c >> 4) & 0xF];
+      buffer_ += hex[c & 0xF];
+    } else {
+      buffer_ += c;
+    }
+  }
+  buffer_ += '"';
+}
+
+/**
+ * @brief Añade un campo de CSV (entre comillas solo si hace falta) o de TSV (escapando \t, \n, \r y \\)
+ */
+void ResultWriter::appendField(std::string_view text, char separator) {
+  if (separator == '\t') {
+    for (char c : text) {
+      switch (c) {
+        case '\t':
+          buffer_ += "\\t";
+          break;
+        case '\n':
+          buffer_ += "\\n";
+          break;
+        case '\r':
+          buffer_ += "\\r";
+          break;
+        case '\\':
+          buffer_ += "\\\\";
+          break;
+        default:
+          buffer_ += c;
+      }
+    }
+    return;
+  }
+
+  if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+    buffer_ += text;
+    return;
+  }
+  buffer_ += '"';
+  for (char c : text) {
+    if (c == '"') {
+      buffer_ += '"';
+    }
+    buffer_ += c;
+  }
+  buffer_ += '"';
+}
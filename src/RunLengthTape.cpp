@@ -0,0 +1,387 @@
+#include "../include/RunLengthTape.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Constructor (cinta vacía)
+ * @param blank_symbol Símbolo blanco de la cinta
+ */
+RunLengthTape::RunLengthTape(char blank_symbol)
+  : blank_symbol_(blank_symbol), run_(0), offset_(0), position_(0), size_(0) {
+  reset("");
+}
+
+/**
+ * @brief Crea una copia de la cinta
+ * @return Copia independiente
+ */
+std::unique_ptr<TapeBackend> RunLengthTape::clone() const {
+  return std::make_unique<RunLengthTape>(*this);
+}
+
+/**
+ * @brief Obtiene el tipo de almacenamiento
+ * @return TapeStorage::RUN_LENGTH
+ */
+TapeStorage RunLengthTape::getStorage() const {
+  return TapeStorage::RUN_LENGTH;
+}
+
+/**
+ * @brief Lee el símbolo en la posición actual del cabezal
+ * @return Símbolo leído
+ */
+char RunLengthTape::read() const {
+  return runs_[run_].symbol;
+}
+
+/**
+ * @brief Escribe un símbolo en la posición actual del cabezal
+ * @param symbol Símbolo a escribir
+ *
+ * Si el símbolo cambia, la racha actual se divide en (antes, celda, después) y la celda se
+ * fusiona con las rachas vecinas del mismo símbolo.
+ */
+void RunLengthTape::write(char symbol) {
+  Run& current = runs_[run_];
+  if (current.symbol != symbol) {
+    if (current.length == 1) {
+      current.symbol = symbol;
+    } else {
+      char old_symbol = current.symbol;
+      uint64_t before = offset_;
+      uint64_t after = current.length - offset_ - 1;
+      current = Run{symbol, 1};
+      if (after > 0) {
+        runs_.insert(runs_.begin() + run_ + 1, Run{old_symbol, after});
+      }
+      if (before > 0) {
+        runs_.insert(runs_.begin() + run_, Run{old_symbol, before});
+        run_++;
+      }
+      offset_ = 0;
+    }
+    
+    if (run_ + 1 < runs_.size()) {
+      mergeWithNext(run_);
+    }
+    if (run_ > 0) {
+      mergeWithNext(run_ - 1);
+    }
+  }
+  
+  if (symbol != blank_symbol_) {
+    if (position_ == 0) {
+      expandLeft();
+    }
+    if (position_ == size_ - 1) {
+      expandRight();
+    }
+  }
+}
+
+/**
+ * @brief Mueve el cabezal a la izquierda (L), expandiendo la cinta si es necesario
+ */
+void RunLengthTape::moveLeft() {
+  if (position_ == 0) {
+    expandLeft();
+  }
+  if (offset_ > 0) {
+    offset_--;
+  } else {
+    run_--;
+    offset_ = runs_[run_].length - 1;
+  }
+  position_--;
+}
+
+/**
+ * @brief Mueve el cabezal a la derecha (R), expandiendo la cinta si es necesario
+ */
+void RunLengthTape::moveRight() {
+  if (position_ == size_ - 1) {
+    expandRight();
+  }
+  if (offset_ + 1 < runs_[run_].length) {
+    offset_++;
+  } else {
+    run_++;
+    offset_ = 0;
+  }
+  position_++;
+}
+
+/**
+ * @brief Mueve el cabezal a la izquierda mientras lea símbolos del conjunto
+ * @param symbols Símbolos que se atraviesan
+ * @param limit Número máximo de movimientos
+ * @return Número de movimientos realizados
+ *
+ * Cada racha del conjunto se atraviesa de una vez; al llegar a la racha blanca del extremo, los
+ * movimientos restantes se resuelven ampliando esa racha.
+ */
+size_t RunLengthTape::scanLeft(const SymbolSet& symbols, size_t limit) {
+  uint64_t moved = 0;
+  while (moved < limit && symbols.contains(runs_[run_].symbol)) {
+    uint64_t remaining = limit - moved;
+    if (run_ == 0 && runs_[0].symbol == blank_symbol_) {
+      if (remaining > position_) {
+        uint64_t added = remaining - position_;
+        runs_[0].length += added;
+        offset_ += added;
+        position_ += added;
+        size_ += added;
+      }
+      offset_ -= remaining;
+      position_ -= remaining;
+      moved = limit;
+      break;
+    }
+    uint64_t steps = std::min<uint64_t>(offset_ + 1, remaining);
+    offset_ -= steps - 1;
+    position_ -= steps - 1;
+    moveLeft();
+    moved += steps;
+  }
+  return static_cast<size_t>(moved);
+}
+
+/**
+ * @brief Mueve el cabezal a la derecha mientras lea símbolos del conjunto
+ * @param symbols Símbolos que se atraviesan
+ * @param limit Número máximo de movimientos
+ * @return Número de movimientos realizados
+ */
+size_t RunLengthTape::scanRight(const SymbolSet& symbols, size_t limit) {
+  uint64_t moved = 0;
+  while (moved < limit && symbols.contains(runs_[run_].symbol)) {
+    uint64_t remaining = limit - moved;
+    if (run_ + 1 == runs_.size() && runs_[run_].symbol == blank_symbol_) {
+      if (position_ + remaining + 1 > size_) {
+        append(blank_symbol_, position_ + remaining + 1 - size_);
+      }
+      offset_ += remaining;
+      position_ += remaining;
+      moved = limit;
+      break;
+    }
+    uint64_t steps = std::min<uint64_t>(runs_[run_].length - offset_, remaining);
+    offset_ += steps - 1;
+    position_ += steps - 1;
+    moveRight();
+    moved += steps;
+  }
+  return static_cast<size_t>(moved);
+}
+
+/**
+ * @brief Obtiene la posición actual del cabezal
+ * @return Posición del cabezal
+ */
+int RunLengthTape::getHeadPosition() const {
+  return static_cast<int>(position_);
+}
+
+/**
+ * @brief Obtiene el número de celdas de la cinta
+ * @return Número de celdas
+ */
+size_t RunLengthTape::getSize() const {
+  return static_cast<size_t>(size_);
+}
+
+/**
+ * @brief Obtiene el contenido de la cinta como string
+ * @return Contenido de la cinta
+ */
+std::string RunLengthTape::getContent() const {
+  std::string content;
+  content.reserve(size_);
+  for (const Run& run : runs_) {
+    content.append(run.length, run.symbol);
+  }
+  return content;
+}
+
+/**
+ * @brief Obtiene el contenido de la cinta con la posición del cabezal marcada
+ * @return String en formato "ab[c]de" donde [c] indica la posición del cabezal
+ */
+std::string RunLengthTape::getContentWithHead() const {
+  std::string content = getContent();
+  std::string result;
+  result.reserve(content.size() + 2);
+  result.append(content, 0, position_);
+  result += '[';
+  result += content[position_];
+  result += ']';
+  result.append(content, position_ + 1, std::string::npos);
+  return result;
+}
+
+/**
+ * @brief Obtiene las celdas [first, last) de la cinta
+ * @param first Primera celda (posición dentro de la cinta)
+ * @param last Celda siguiente a la última
+ * @return Contenido de esas celdas
+ *
+ * Se parte de la racha del cabezal, así que una ventana a su alrededor solo recorre sus rachas.
+ */
+std::string RunLengthTape::getRange(size_t first, size_t last) const {
+  std::string content;
+  if (first >= last) {
+    return content;
+  }
+  content.reserve(last - first);
+  size_t run = run_;
+  uint64_t start = position_ - offset_;
+  while (start > first) {
+    start -= runs_[--run].length;
+  }
+  for (; start < last; start += runs_[run++].length) {
+    uint64_t from = std::max<uint64_t>(start, first);
+    uint64_t to = std::min<uint64_t>(start + runs_[run].length, last);
+    content.append(to - from, runs_[run].symbol);
+  }
+  return content;
+}
+
+/**
+ * @brief Obtiene el contenido de la cinta sin los blancos de los extremos
+ * @return Contenido entre la primera y la última celda no blanca (vacío si todo es blanco)
+ *
+ * Se descartan las rachas blancas de los extremos sin expandirlas.
+ */
+std::string RunLengthTape::getTrimmedContent() const {
+  size_t first = 0;
+  size_t last = runs_.size();
+  while (first < last && runs_[first].symbol == blank_symbol_) {
+    first++;
+  }
+  while (last > first && runs_[last - 1].symbol == blank_symbol_) {
+    last--;
+  }
+  std::string content;
+  for (size_t i = first; i < last; ++i) {
+    content.append(runs_[i].length, runs_[i].symbol);
+  }
+  return content;
+}
+
+/**
+ * @brief Reinicia la cinta con una nueva cadena de entrada
+ * @param input Nueva cadena de entrada
+ */
+void RunLengthTape::reset(std::string_view input) {
+  runs_.clear();
+  size_ = 0;
+  append(blank_symbol_, 1);
+  if (input.empty()) {
+    append(blank_symbol_, 1);
+  } else {
+    for (char c : input) {
+      append(c, 1);
+    }
+  }
+  append(blank_symbol_, 1);
+  
+  position_ = 1;
+  run_ = 0;
+  offset_ = 1;
+  if (runs_[0].length == 1) {
+    run_ = 1;
+    offset_ = 0;
+  }
+}
+
+/**
+ * @brief Carga una configuración exacta de la cinta
+ * @param content Contenido completo de la cinta
+ * @param head_position Posición del cabezal dentro de content
+ * @throws std::invalid_argument si la posición del cabezal queda fuera del contenido
+ */
+void RunLengthTape::load(const std::string& content, int head_position) {
+  if (head_position < 0 || static_cast<size_t>(head_position) >= content.size()) {
+    throw std::invalid_argument("La posición del cabezal debe estar dentro de la cinta");
+  }
+  
+  runs_.clear();
+  size_ = 0;
+  for (char c : content) {
+    append(c, 1);
+  }
+  
+  position_ = static_cast<uint64_t>(head_position);
+  uint64_t start = 0;
+  run_ = 0;
+  while (start + runs_[run_].length <= position_) {
+    start += runs_[run_].length;
+    run_++;
+  }
+  offset_ = position_ - start;
+}
+
+/**
+ * @brief Obtiene el número de rachas almacenadas
+ * @return Número de segmentos (símbolo, longitud)
+ */
+size_t RunLengthTape::getRunCount() const {
+  return runs_.size();
+}
+
+/**
+ * @brief Expande la cinta hacia la izquierda con un símbolo blanco
+ */
+void RunLengthTape::expandLeft() {
+  if (runs_.front().symbol == blank_symbol_) {
+    runs_.front().length++;
+    if (run_ == 0) {
+      offset_++;
+    }
+  } else {
+    runs_.insert(runs_.begin(), Run{blank_symbol_, 1});
+    run_++;
+  }
+  position_++;
+  size_++;
+}
+
+/**
+ * @brief Expande la cinta hacia la derecha con un símbolo blanco
+ */
+void RunLengthTape::expandRight() {
+  append(blank_symbol_, 1);
+}
+
+/**
+ * @brief Añade celdas al final de la cinta, fusionando con la última racha si coincide el símbolo
+ * @param symbol Símbolo de las celdas
+ * @param length Número de celdas
+ */
+void RunLengthTape::append(char symbol, uint64_t length) {
+  if (!runs_.empty() && runs_.back().symbol == symbol) {
+    runs_.back().length += length;
+  } else {
+    runs_.push_back(Run{symbol, length});
+  }
+  size_ += length;
+}
+
+/**
+ * @brief Fusiona una racha con la siguiente si tienen el mismo símbolo
+ * @param index Índice de la racha
+ */
+void RunLengthTape::mergeWithNext(size_t index) {
+  if (runs_[index].symbol != runs_[index + 1].symbol) {
+    return;
+  }
+  if (run_ == index + 1) {
+    run_ = index;
+    offset_ += runs_[index].length;
+  } else if (run_ > index + 1) {
+    run_--;
+  }
+  runs_[index].length += runs_[index + 1].length;
+  runs_.erase(runs_.begin() + index + 1);
+}
@@ -1,15 +1,18 @@
 #include "../include/Tape.hpp"
-#include <sstream>
+#include "../include/PackedTape.hpp"
+#include "../include/RunLengthTape.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
 /**
  * @brief Constructor con símbolo blanco (cinta vacía)
  * @param blank_symbol Símbolo blanco de la cinta
  */
 Tape::Tape(char blank_symbol) 
-  : blank_symbol_(blank_symbol), head_position_(1) {
-  tape_.push_back(blank_symbol_);
-  tape_.push_back(blank_symbol_);
-  tape_.push_back(blank_symbol_);
+  : buffer_(kInitialCapacity, blank_symbol), blank_symbol_(blank_symbol),
+    begin_(0), end_(0), head_(0), origin_(kInitialCapacity / 2), written_begin_(0), written_end_(0) {
+  reset("");
 }
 
 /**
@@ -18,70 +21,130 @@ Tape::Tape(char blank_symbol)
  * @param blank_symbol Símbolo blanco de la cinta
  */
 Tape::Tape(const std::string& input, char blank_symbol)
-  : blank_symbol_(blank_symbol), head_position_(1) {
-  
-  tape_.push_back(blank_symbol_);
-  if (input.empty()) {
-    tape_.push_back(blank_symbol_);
-  } else {
-    for (char c : input) {
-      tape_.push_back(c);
-    }
-  }
-  tape_.push_back(blank_symbol_);
+  : buffer_(kInitialCapacity, blank_symbol), blank_symbol_(blank_symbol),
+    begin_(0), end_(0), head_(0), origin_(kInitialCapacity / 2), written_begin_(0), written_end_(0) {
+  reset(input);
 }
 
 /**
- * @brief Lee el símbolo en la posición actual del cabezal
- * @return Símbolo leído
+ * @brief Constructor de copia (copia también el almacenamiento alternativo, si lo hay)
+ * @param other Cinta a copiar
+ */
+Tape::Tape(const Tape& other)
+  : buffer_(other.buffer_), blank_symbol_(other.blank_symbol_), begin_(other.begin_), end_(other.end_),
+    head_(other.head_), origin_(other.origin_), written_begin_(other.written_begin_),
+    written_end_(other.written_end_), backend_(other.backend_ ? other.backend_->clone() : nullptr) {}
+
+/**
+ * @brief Asignación por copia
+ * @param other Cinta a copiar
+ * @return Referencia a esta cinta
  */
-char Tape::read() const {
-  return tape_[head_position_];
+Tape& Tape::operator=(const Tape& other) {
+  if (this != &other) {
+    Tape copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
 }
 
 /**
- * @brief Escribe un símbolo en la posición actual del cabezal
- * @param symbol Símbolo a escribir
+ * @brief Cambia el almacenamiento de la cinta conservando su contenido y el cabezal
+ * @param storage Almacenamiento a usar
+ * @param symbols Símbolos que puede contener la cinta (solo para TapeStorage::PACKED)
+ * @throws std::invalid_argument si la cinta empaquetada no recibe el alfabeto
  */
-void Tape::write(char symbol) {
-  tape_[head_position_] = symbol;
-  
-  if (head_position_ == 0 && tape_[0] != blank_symbol_) {
-    expandLeft();
+void Tape::setStorage(TapeStorage storage, const Alphabet& symbols) {
+  if (storage == getStorage()) {
+    return;
   }
-  if (head_position_ == static_cast<int>(tape_.size()) - 1 && 
-      tape_[head_position_] != blank_symbol_) {
-    expandRight();
+  
+  std::string content = getContent();
+  int head_position = getHeadPosition();
+  
+  switch (storage) {
+    case TapeStorage::CONTIGUOUS:
+      backend_.reset();
+      break;
+    case TapeStorage::RUN_LENGTH:
+      backend_ = std::make_unique<RunLengthTape>(blank_symbol_);
+      break;
+    case TapeStorage::PACKED:
+      if (symbols.isEmpty()) {
+        throw std::invalid_argument("La cinta empaquetada necesita el alfabeto de la cinta");
+      }
+      backend_ = std::make_unique<PackedTape>(blank_symbol_, symbols);
+      break;
   }
+  load(content, head_position);
 }
 
 /**
- * @brief Mueve el cabezal a la izquierda (L)
- * Expande la cinta si es necesario
+ * @brief Obtiene el almacenamiento que usa la cinta
+ * @return Tipo de almacenamiento
  */
-void Tape::moveLeft() {
-  if (head_position_ == 0) {
-    expandLeft();
-  }
-  head_position_--;
+TapeStorage Tape::getStorage() const {
+  return backend_ ? backend_->getStorage() : TapeStorage::CONTIGUOUS;
 }
 
 /**
- * @brief Mueve el cabezal a la derecha (R)
- * Expande la cinta si es necesario
+ * @brief Mueve el cabezal a la izquierda mientras lea símbolos del conjunto
+ * @param symbols Símbolos que se atraviesan
+ * @param limit Número máximo de movimientos
+ * @return Número de movimientos realizados
+ *
+ * Equivale a repetir moveLeft() mientras read() pertenezca al conjunto, con la misma extensión
+ * final de la cinta. Las celdas de fuera de la cinta son blancos, así que se examina todo el
+ * buffer (duplicándolo si hace falta) y después se ajusta el extremo izquierdo.
  */
-void Tape::moveRight() {
-  head_position_++;
-  if (head_position_ >= static_cast<int>(tape_.size())) {
-    expandRight();
+size_t Tape::scanLeft(const SymbolSet& symbols, size_t limit) {
+  if (backend_) {
+    return backend_->scanLeft(symbols, limit);
   }
+  
+  size_t moved = 0;
+  while (moved < limit) {
+    if (head_ == 0) {
+      growLeft();
+    }
+    size_t span = std::min(limit - moved, head_);
+    size_t count = symbols.spanBackward(buffer_.data() + head_, span);
+    head_ -= count;
+    moved += count;
+    if (count < span) {
+      break;
+    }
+  }
+  begin_ = std::min(begin_, head_);
+  return moved;
 }
 
 /**
- * @brief Mantiene el cabezal en la posición actual (S)
+ * @brief Mueve el cabezal a la derecha mientras lea símbolos del conjunto
+ * @param symbols Símbolos que se atraviesan
+ * @param limit Número máximo de movimientos
+ * @return Número de movimientos realizados
  */
-void Tape::moveStay() {
-  // No hace nada, el cabezal permanece en su posición
+size_t Tape::scanRight(const SymbolSet& symbols, size_t limit) {
+  if (backend_) {
+    return backend_->scanRight(symbols, limit);
+  }
+  
+  size_t moved = 0;
+  while (moved < limit) {
+    if (head_ == buffer_.size() - 1) {
+      growRight();
+    }
+    size_t span = std::min(limit - moved, buffer_.size() - 1 - head_);
+    size_t count = symbols.spanForward(buffer_.data() + head_, span);
+    head_ += count;
+    moved += count;
+    if (count < span) {
+      break;
+    }
+  }
+  end_ = std::max(end_, head_ + 1);
+  return moved;
 }
 
 /**
@@ -89,7 +152,21 @@ void Tape::moveStay() {
  * @return Posición del cabezal
  */
 int Tape::getHeadPosition() const {
-  return head_position_;
+  if (backend_) {
+    return backend_->getHeadPosition();
+  }
+  return static_cast<int>(head_ - begin_);
+}
+
+/**
+ * @brief Obtiene el número de celdas de la cinta
+ * @return Número de celdas (incluidos los blancos de los extremos)
+ */
+size_t Tape::getSize() const {
+  if (backend_) {
+    return backend_->getSize();
+  }
+  return end_ - begin_;
 }
 
 /**
@@ -97,11 +174,10 @@ int Tape::getHeadPosition() const {
  * @return Contenido de la cinta
  */
 std::string Tape::getContent() const {
-  std::string content;
-  for (char c : tape_) {
-    content += c;
+  if (backend_) {
+    return backend_->getContent();
   }
-  return content;
+  return std::string(buffer_.data() + begin_, end_ - begin_);
 }
 
 /**
@@ -109,49 +185,215 @@ std::string Tape::getContent() const {
  * @return String en formato "ab[c]de" donde [c] indica la posición del cabezal
  */
 std::string Tape::getContentWithHead() const {
-  std::ostringstream oss;
-  for (int i = 0; i < static_cast<int>(tape_.size()); ++i) {
-    if (i == head_position_) {
-      oss << '[' << tape_[i] << ']';
-    } else {
-      oss << tape_[i];
-    }
+  if (backend_) {
+    return backend_->getContentWithHead();
   }
-  return oss.str();
+  
+  std::string content;
+  content.reserve(end_ - begin_ + 2);
+  content.append(buffer_.data() + begin_, head_ - begin_);
+  content += '[';
+  content += buffer_[head_];
+  content += ']';
+  content.append(buffer_.data() + head_ + 1, end_ - head_ - 1);
+  return content;
+}
+
+/**
+ * @brief Obtiene el contenido de la cinta sin los blancos de los extremos
+ * @return Contenido entre la primera y la última celda no blanca (vacío si todo es blanco)
+ */
+std::string Tape::getTrimmedContent() const {
+  if (backend_) {
+    return backend_->getTrimmedContent();
+  }
+  return std::string(getNonBlankView());
+}
+
+/**
+ * @brief Obtiene una vista de toda la cinta
+ * @return Celdas de la cinta (incluidos los blancos de los extremos)
+ */
+std::string_view Tape::getView() const {
+  if (backend_) {
+    materialized_ = backend_->getContent();
+    return materialized_;
+  }
+  return std::string_view(buffer_.data() + begin_, end_ - begin_);
+}
+
+/**
+ * @brief Obtiene una vista del tramo entre la primera y la última celda no blanca
+ * @return Tramo no blanco (vacío si todo es blanco)
+ */
+std::string_view Tape::getNonBlankView() const {
+  size_t first;
+  return getNonBlankView(first);
+}
+
+/**
+ * @brief Obtiene una vista del tramo entre la primera y la última celda no blanca
+ * @param first Posición del tramo dentro de la cinta (0 si todo es blanco)
+ * @return Tramo no blanco (vacío si todo es blanco)
+ *
+ * Solo se recorren los blancos que hayan quedado dentro de la cota del tramo escrito.
+ */
+std::string_view Tape::getNonBlankView(size_t& first) const {
+  std::string_view cells;
+  size_t offset;
+  if (backend_) {
+    materialized_ = backend_->getContent();
+    cells = materialized_;
+    offset = 0;
+  } else {
+    cells = std::string_view(buffer_.data() + written_begin_, written_end_ - written_begin_);
+    offset = written_begin_ - begin_;
+  }
+  
+  size_t start = cells.find_first_not_of(blank_symbol_);
+  if (start == std::string_view::npos) {
+    first = 0;
+    return std::string_view();
+  }
+  first = offset + start;
+  return cells.substr(start, cells.find_last_not_of(blank_symbol_) - start + 1);
+}
+
+/**
+ * @brief Obtiene una vista de las celdas alrededor del cabezal
+ * @param radius Celdas a cada lado del cabezal
+ * @param head_offset Posición del cabezal dentro de la vista
+ * @return Celdas [cabezal - radius, cabezal + radius] que pertenecen a la cinta
+ */
+std::string_view Tape::getWindow(size_t radius, size_t& head_offset) const {
+  size_t head = static_cast<size_t>(getHeadPosition());
+  size_t first = head - std::min(radius, head);
+  size_t last = std::min(getSize(), head + std::min(radius, getSize()) + 1);
+  head_offset = head - first;
+  if (backend_) {
+    materialized_ = backend_->getRange(first, last);
+    return materialized_;
+  }
+  return std::string_view(buffer_.data() + begin_ + first, last - first);
 }
 
 /**
  * @brief Reinicia la cinta con una nueva cadena de entrada
  * @param input Nueva cadena de entrada
+ *
+ * Conserva la capacidad del buffer: solo limpia las celdas usadas en la ejecución anterior
+ * y copia la entrada en bloque a partir del origen de la cinta.
  */
-void Tape::reset(const std::string& input) {
-  tape_.clear();
-  head_position_ = 1;
+void Tape::reset(std::string_view input) {
+  if (backend_) {
+    backend_->reset(input);
+    return;
+  }
+  
+  std::fill(buffer_.begin() + begin_, buffer_.begin() + end_, blank_symbol_);
+  
+  size_t length = std::max<size_t>(input.size(), 1) + 2;
+  while (origin_ + length > buffer_.size()) {
+    growRight();
+  }
   
-  tape_.push_back(blank_symbol_);
-  if (input.empty()) {
-    tape_.push_back(blank_symbol_);
+  begin_ = origin_;
+  end_ = begin_ + length;
+  head_ = begin_ + 1;
+  written_begin_ = head_;
+  written_end_ = head_ + input.size();
+  if (!input.empty()) {
+    std::memcpy(buffer_.data() + head_, input.data(), input.size());
+  }
+}
+
+/**
+ * @brief Carga una configuración exacta de la cinta
+ * @param content Contenido completo de la cinta (tal como lo devuelve getContent())
+ * @param head_position Posición del cabezal dentro de content
+ * @throws std::invalid_argument si la posición del cabezal queda fuera del contenido
+ */
+void Tape::load(const std::string& content, int head_position) {
+  if (backend_) {
+    backend_->load(content, head_position);
+    return;
+  }
+  if (head_position < 0 || static_cast<size_t>(head_position) >= content.size()) {
+    throw std::invalid_argument("La posición del cabezal debe estar dentro de la cinta");
+  }
+  
+  std::fill(buffer_.begin() + begin_, buffer_.begin() + end_, blank_symbol_);
+  while (origin_ + content.size() > buffer_.size()) {
+    growRight();
+  }
+  
+  begin_ = origin_;
+  end_ = begin_ + content.size();
+  head_ = begin_ + head_position;
+  std::memcpy(buffer_.data() + begin_, content.data(), content.size());
+  
+  size_t first = content.find_first_not_of(blank_symbol_);
+  if (first == std::string::npos) {
+    written_begin_ = head_;
+    written_end_ = head_;
   } else {
-    for (char c : input) {
-      tape_.push_back(c);
-    }
+    written_begin_ = begin_ + first;
+    written_end_ = begin_ + content.find_last_not_of(blank_symbol_) + 1;
   }
-  tape_.push_back(blank_symbol_);
 }
 
 /**
  * @brief Expande la cinta hacia la izquierda
- * Añade un símbolo blanco al inicio y ajusta la posición del cabezal
+ * Añade un símbolo blanco al inicio (las celdas fuera de la cinta ya son blancos)
  */
 void Tape::expandLeft() {
-  tape_.push_front(blank_symbol_);
-  head_position_++;
+  if (begin_ == 0) {
+    growLeft();
+  }
+  begin_--;
 }
 
 /**
  * @brief Expande la cinta hacia la derecha
- * Añade un símbolo blanco al final
+ * Añade un símbolo blanco al final (las celdas fuera de la cinta ya son blancos)
  */
 void Tape::expandRight() {
-  tape_.push_back(blank_symbol_);
+  if (end_ == buffer_.size()) {
+    growRight();
+  }
+  end_++;
+}
+
+/**
+ * @brief Amplía la cota del tramo escrito hasta la celda del cabezal
+ */
+void Tape::extendWritten() {
+  if (written_begin_ == written_end_) {
+    written_begin_ = head_;
+    written_end_ = head_ + 1;
+    return;
+  }
+  written_begin_ = std::min(written_begin_, head_);
+  written_end_ = std::max(written_end_, head_ + 1);
+}
+
+/**
+ * @brief Duplica la capacidad del buffer añadiendo el espacio nuevo a la izquierda
+ */
+void Tape::growLeft() {
+  size_t added = buffer_.size();
+  buffer_.insert(buffer_.begin(), added, blank_symbol_);
+  begin_ += added;
+  end_ += added;
+  head_ += added;
+  origin_ += added;
+  written_begin_ += added;
+  written_end_ += added;
+}
+
+/**
+ * @brief Duplica la capacidad del buffer añadiendo el espacio nuevo a la derecha
+ */
+void Tape::growRight() {
+  buffer_.resize(buffer_.size() * 2, blank_symbol_);
 }
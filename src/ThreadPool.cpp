@@ -0,0 +1,138 @@
+#include "../include/ThreadPool.hpp"
+
+namespace {
+
+// Pool e índice del hilo actual (nullptr fuera de los hilos de un pool)
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+}  // namespace
+
+/**
+ * @brief Crea el pool y arranca sus hilos
+ * @param num_threads Número de hilos (al menos 1)
+ */
+ThreadPool::ThreadPool(size_t num_threads)
+  : queued_(0), pending_(0), next_queue_(0), stopping_(false) {
+  if (num_threads == 0) {
+    num_threads = 1;
+  }
+  for (size_t i = 0; i < num_threads; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+/**
+ * @brief Espera a que terminen las tareas pendientes y detiene los hilos
+ */
+ThreadPool::~ThreadPool() {
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+/**
+ * @brief Envía una tarea al pool
+ * @param task Tarea a ejecutar; recibe el índice del hilo que la ejecuta
+ *
+ * Desde un hilo del pool la tarea se encola en su propia cola; desde fuera, se reparte
+ * entre las colas de forma rotatoria.
+ */
+void ThreadPool::submit(Task task) {
+  size_t index = current_pool == this ? current_worker : next_queue_++ % queues_.size();
+  pending_++;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_++;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  work_available_.notify_one();
+}
+
+/**
+ * @brief Bloquea hasta que todas las tareas enviadas (y sus subtareas) hayan terminado
+ */
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  all_done_.wait(lock, [this] { return pending_ == 0; });
+}
+
+/**
+ * @brief Obtiene el número de hilos del pool
+ * @return Número de hilos
+ */
+size_t ThreadPool::size() const {
+  return threads_.size();
+}
+
+/**
+ * @brief Bucle de cada hilo: ejecuta tareas propias o robadas hasta que se detiene el pool
+ * @param index Índice del hilo
+ */
+void ThreadPool::workerLoop(size_t index) {
+  current_pool = this;
+  current_worker = index;
+
+  while (true) {
+    Task task;
+    if (tryPop(index, task)) {
+      task(index);
+      task = nullptr;
+      if (--pending_ == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        all_done_.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_available_.wait(lock, [this] { return queued_ > 0 || stopping_; });
+    if (stopping_ && queued_ == 0) {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Obtiene una tarea: primero de la cola propia, después robando de las demás
+ * @param index Índice del hilo
+ * @param task Tarea obtenida
+ * @return true si se obtuvo una tarea
+ */
+bool ThreadPool::tryPop(size_t index, Task& task) {
+  {
+    WorkerQueue& own = *queues_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      queued_--;
+      return true;
+    }
+  }
+
+  for (size_t offset = 1; offset < queues_.size(); ++offset) {
+    WorkerQueue& victim = *queues_[(index + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      queued_--;
+      return true;
+    }
+  }
+
+  return false;
+}
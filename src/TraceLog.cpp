@@ -0,0 +1,290 @@
+#include "../include/TraceLog.hpp"
+#include "../include/TuringMachine.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[4] = {'M', 'T', 'T', 'R'};
+const uint32_t kVersion = 1;
+
+// Primer varint de los registros de control: (tipo << 1) | 1
+const uint64_t kRunBegin = (0 << 1) | 1;
+const uint64_t kRunEnd = (1 << 1) | 1;
+
+}  // namespace
+
+/**
+ * @brief Crea el fichero de traza y escribe su cabecera
+ * @param path Ruta del fichero
+ * @param program Máquina compilada que se va a trazar
+ * @throws std::runtime_error si el fichero no se puede crear
+ */
+TraceWriter::TraceWriter(const std::string& path, const CompiledMachine& program)
+  : file_(std::fopen(path.c_str(), "wb")),
+    path_(path),
+    buffer_(kBufferSize),
+    used_(0),
+    num_tapes_(program.getNumTapes()),
+    last_transition_(0) {
+  if (file_ == nullptr) {
+    throw std::runtime_error("No se pudo crear el fichero de traza: " + path);
+  }
+
+  reserve(sizeof(kMagic));
+  std::memcpy(buffer_.data(), kMagic, sizeof(kMagic));
+  used_ = sizeof(kMagic);
+  reserve(4 * 10);
+  putVarint(kVersion);
+  putVarint(num_tapes_);
+  putByte(static_cast<uint8_t>(program.getBlankSymbol()));
+  putVarint(program.getNumStates());
+  for (uint32_t state = 0; state < program.getNumStates(); ++state) {
+    const std::string& name = program.getStateName(state);
+    reserve(10 + name.size() + 1);
+    putVarint(name.size());
+    for (char c : name) {
+      putByte(static_cast<uint8_t>(c));
+    }
+    putByte(program.isFinal(state) ? 1 : 0);
+  }
+}
+
+/**
+ * @brief Vuelca lo pendiente y cierra el fichero
+ *
+ * Un error de escritura al destruir el objeto se ignora; para detectarlo hay que llamar antes
+ * a flush().
+ */
+TraceWriter::~TraceWriter() {
+  try {
+    flush();
+  } catch (const std::exception&) {
+  }
+  std::fclose(file_);
+}
+
+/**
+ * @brief Escribe el inicio de una ejecución
+ * @param input Cadena de entrada
+ * @param state Estado inicial
+ */
+void TraceWriter::beginRun(std::string_view input, uint32_t state) {
+  reserve(3 * 10);
+  putVarint(kRunBegin);
+  putVarint(state);
+  putVarint(input.size());
+  size_t offset = 0;
+  while (offset < input.size()) {
+    reserve(1);
+    size_t count = std::min(input.size() - offset, buffer_.size() - used_);
+    std::memcpy(buffer_.data() + used_, input.data() + offset, count);
+    used_ += count;
+    offset += count;
+  }
+  last_transition_ = 0;
+}
+
+/**
+ * @brief Escribe el final de una ejecución
+ * @param steps Pasos ejecutados
+ * @param status Cómo terminó la ejecución
+ * @param state Estado final
+ */
+void TraceWriter::endRun(size_t steps, RunStatus status, uint32_t state) {
+  reserve(3 * 10 + 1);
+  putVarint(kRunEnd);
+  putVarint(steps);
+  putByte(static_cast<uint8_t>(status));
+  putVarint(state);
+}
+
+/**
+ * @brief Vuelca el buffer al fichero
+ * @throws std::runtime_error si no se puede escribir
+ */
+void TraceWriter::flush() {
+  if (used_ > 0 && std::fwrite(buffer_.data(), 1, used_, file_) != used_) {
+    used_ = 0;
+    throw std::runtime_error("No se pudo escribir el fichero de traza: " + path_);
+  }
+  used_ = 0;
+  std::fflush(file_);
+}
+
+/**
+ * @brief Abre una traza y lee su cabecera
+ * @param path Ruta del fichero
+ * @throws std::runtime_error si el fichero no existe o no es una traza válida
+ */
+TraceReader::TraceReader(const std::string& path)
+  : position_(0), path_(path), num_tapes_(0), blank_symbol_('.'), last_transition_(0) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("No se pudo abrir el fichero de traza: " + path);
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  data_ = content.str();
+
+  if (data_.size() < sizeof(kMagic) || std::memcmp(data_.data(), kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("El fichero no es una traza de la máquina de Turing: " + path);
+  }
+  position_ = sizeof(kMagic);
+  if (getVarint() != kVersion) {
+    throw std::runtime_error("Versión de traza no soportada: " + path);
+  }
+  num_tapes_ = getVarint();
+  blank_symbol_ = static_cast<char>(getByte());
+  uint64_t num_states = getVarint();
+  if (num_tapes_ == 0 || num_tapes_ > data_.size() || num_states == 0 || num_states > data_.size()) {
+    throw std::runtime_error("Traza inválida: " + path);
+  }
+  for (uint64_t state = 0; state < num_states; ++state) {
+    uint64_t length = getVarint();
+    if (length > data_.size() - position_) {
+      throw std::runtime_error("Traza inválida: " + path);
+    }
+    state_names_.push_back(data_.substr(position_, length));
+    position_ += length;
+    final_.push_back(static_cast<char>(getByte()));
+  }
+}
+
+/**
+ * @brief Lee el siguiente registro
+ * @param event Registro leído
+ * @return false al llegar al final de la traza
+ * @throws std::runtime_error si la traza está truncada o es inválida
+ */
+bool TraceReader::next(TraceEvent& event) {
+  if (position_ == data_.size()) {
+    return false;
+  }
+
+  uint64_t tag = getVarint();
+  if (tag == kRunBegin) {
+    event.kind = TraceEvent::Kind::RUN_BEGIN;
+    event.state = getState();
+    uint64_t length = getVarint();
+    if (length > data_.size() - position_) {
+      throw std::runtime_error("Traza truncada: " + path_);
+    }
+    event.input = data_.substr(position_, length);
+    position_ += length;
+    last_transition_ = 0;
+    return true;
+  }
+  if (tag == kRunEnd) {
+    event.kind = TraceEvent::Kind::RUN_END;
+    event.steps = getVarint();
+    event.status = static_cast<RunStatus>(getByte());
+    event.state = getState();
+    return true;
+  }
+  if (tag & 1) {
+    throw std::runtime_error("Traza inválida: " + path_);
+  }
+
+  uint64_t zigzag = tag >> 1;
+  int64_t delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+  last_transition_ = static_cast<int32_t>(last_transition_ + delta);
+  event.kind = TraceEvent::Kind::STEP;
+  event.transition = last_transition_;
+  event.state = getState();
+
+  event.changed.assign(num_tapes_, 0);
+  event.writes.assign(num_tapes_, blank_symbol_);
+  size_t mask_at = position_;
+  position_ += (num_tapes_ + 7) / 8;
+  if (position_ > data_.size()) {
+    throw std::runtime_error("Traza truncada: " + path_);
+  }
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    if (static_cast<uint8_t>(data_[mask_at + i / 8]) & (1u << (i % 8))) {
+      event.changed[i] = 1;
+      event.writes[i] = static_cast<char>(getByte());
+    }
+  }
+
+  event.moves.resize(num_tapes_);
+  uint8_t moves = 0;
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    if (i % 4 == 0) {
+      moves = getByte();
+    }
+    uint8_t move = (moves >> (2 * (i % 4))) & 3;
+    if (move > static_cast<uint8_t>(Movement::STAY)) {
+      throw std::runtime_error("Traza inválida: " + path_);
+    }
+    event.moves[i] = static_cast<Movement>(move);
+  }
+  return true;
+}
+
+/**
+ * @brief Obtiene el número de cintas de la máquina trazada
+ * @return Número de cintas
+ */
+size_t TraceReader::getNumTapes() const {
+  return num_tapes_;
+}
+
+/**
+ * @brief Obtiene el símbolo blanco de la máquina trazada
+ * @return Símbolo blanco
+ */
+char TraceReader::getBlankSymbol() const {
+  return blank_symbol_;
+}
+
+/**
+ * @brief Obtiene el nombre de un estado
+ * @param state Identificador del estado
+ * @return Nombre del estado
+ */
+const std::string& TraceReader::getStateName(uint32_t state) const {
+  return state_names_.at(state);
+}
+
+/**
+ * @brief Indica si un estado es final
+ * @param state Identificador del estado
+ * @return true si el estado pertenece a F
+ */
+bool TraceReader::isFinal(uint32_t state) const {
+  return final_.at(state) != 0;
+}
+
+uint8_t TraceReader::getByte() {
+  if (position_ >= data_.size()) {
+    throw std::runtime_error("Traza truncada: " + path_);
+  }
+  return static_cast<uint8_t>(data_[position_++]);
+}
+
+uint64_t TraceReader::getVarint() {
+  uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = getByte();
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Traza inválida: " + path_);
+}
+
+/**
+ * @brief Lee un identificador de estado comprobando que existe
+ */
+uint32_t TraceReader::getState() {
+  uint64_t state = getVarint();
+  if (state >= state_names_.size()) {
+    throw std::runtime_error("Traza inválida: " + path_);
+  }
+  return static_cast<uint32_t>(state);
+}
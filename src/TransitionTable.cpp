@@ -0,0 +1,293 @@
+#include "../include/TransitionTable.hpp"
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Constructor por defecto (tabla vacía sin estados)
+ */
+TransitionTable::TransitionTable()
+  : num_states_(0), num_tapes_(0), radix_(1), packed_(true), dense_(true), dense_data_(nullptr) {
+  codes_.fill(-1);
+}
+
+/**
+ * @brief Constructor de la tabla para una máquina concreta
+ * @param num_states Número de estados (los índices de estado van de 0 a num_states - 1)
+ * @param tape_alphabet Alfabeto de cinta Γ
+ * @param num_tapes Número de cintas
+ * @param external_dense Tabla densa ya construida (getDenseData() de una tabla equivalente) que
+ *                       se usa sin copiarla si la representación elegida es densa
+ * @param num_keys Número de claves exactas que se van a insertar (SIZE_MAX si no se conoce)
+ *
+ * Elige la representación según el tamaño del espacio de claves |Q|·|Γ|^k y su ocupación.
+ */
+TransitionTable::TransitionTable(size_t num_states, const Alphabet& tape_alphabet, size_t num_tapes,
+                                 const int32_t* external_dense, size_t num_keys)
+  : num_states_(num_states), num_tapes_(num_tapes), radix_(tape_alphabet.size()),
+    packed_(true), dense_(false), dense_data_(nullptr) {
+  codes_.fill(-1);
+  int16_t code = 0;
+  for (char symbol : tape_alphabet.getSymbols()) {
+    codes_[static_cast<unsigned char>(symbol)] = code++;
+  }
+  if (radix_ == 0) {
+    radix_ = 1;
+  }
+  chooseRepresentation(external_dense, num_keys);
+}
+
+/**
+ * @brief Constructor de la tabla de un patrón, con los códigos de símbolo de la tabla principal
+ * @param num_states Número de estados
+ * @param codes Código de cada símbolo de Γ (-1 si no pertenece)
+ * @param radix |Γ|
+ * @param num_tapes Número de cintas con símbolo concreto del patrón
+ *
+ * Las filas con comodines suelen ser pocas, así que la tabla solo es densa si su espacio de
+ * claves es pequeño.
+ */
+TransitionTable::TransitionTable(size_t num_states, const std::array<int16_t, 256>& codes, uint64_t radix,
+                                 size_t num_tapes)
+  : num_states_(num_states), num_tapes_(num_tapes), radix_(radix), codes_(codes),
+    packed_(true), dense_(false), dense_data_(nullptr) {
+  chooseRepresentation(nullptr, 0);
+}
+
+/**
+ * @brief Elige la representación según el tamaño del espacio de claves |Q|·|Γ|^k
+ * @param external_dense Tabla densa ya construida que se usa sin copiarla si la tabla es densa
+ * @param num_keys Número de claves que se van a insertar (SIZE_MAX si no se conoce)
+ */
+void TransitionTable::chooseRepresentation(const int32_t* external_dense, size_t num_keys) {
+  // Calcular |Q|·|Γ|^k comprobando desbordamiento de 64 bits
+  uint64_t total = num_states_ == 0 ? 1 : num_states_;
+  for (size_t i = 0; i < num_tapes_ && packed_; ++i) {
+    if (total > std::numeric_limits<uint64_t>::max() / radix_) {
+      packed_ = false;
+    } else {
+      total *= radix_;
+    }
+  }
+
+  bool occupied = total <= kSparseEntries || num_keys == SIZE_MAX || total / kMaxSparsity <= num_keys;
+  if (packed_ && total <= kMaxDenseEntries && occupied) {
+    dense_ = true;
+    if (external_dense != nullptr) {
+      dense_data_ = external_dense;
+    } else {
+      dense_table_.assign(total, kNoTransition);
+      dense_data_ = dense_table_.data();
+    }
+  }
+}
+
+/**
+ * @brief Constructor de copia (la tabla densa propia se copia; una adjunta se comparte)
+ * @param other Tabla a copiar
+ */
+TransitionTable::TransitionTable(const TransitionTable& other)
+  : num_states_(other.num_states_), num_tapes_(other.num_tapes_), radix_(other.radix_),
+    codes_(other.codes_), packed_(other.packed_), dense_(other.dense_),
+    dense_table_(other.dense_table_), dense_data_(other.dense_data_),
+    packed_table_(other.packed_table_), wide_table_(other.wide_table_), patterns_(other.patterns_) {
+  if (!dense_table_.empty()) {
+    dense_data_ = dense_table_.data();
+  }
+}
+
+/**
+ * @brief Asignación por copia
+ * @param other Tabla a copiar
+ * @return Referencia a esta tabla
+ */
+TransitionTable& TransitionTable::operator=(const TransitionTable& other) {
+  if (this != &other) {
+    num_states_ = other.num_states_;
+    num_tapes_ = other.num_tapes_;
+    radix_ = other.radix_;
+    codes_ = other.codes_;
+    packed_ = other.packed_;
+    dense_ = other.dense_;
+    dense_table_ = other.dense_table_;
+    dense_data_ = dense_table_.empty() ? other.dense_data_ : dense_table_.data();
+    packed_table_ = other.packed_table_;
+    wide_table_ = other.wide_table_;
+    patterns_ = other.patterns_;
+  }
+  return *this;
+}
+
+/**
+ * @brief Inserta una transición en la tabla
+ * @param state Índice del estado actual
+ * @param symbols Símbolos leídos (uno por cinta, en Γ o el comodín)
+ * @param index Índice de la transición en δ
+ *
+ * Si ya existe una transición para la misma clave se conserva la primera,
+ * igual que en la búsqueda lineal original. Una tabla densa externa se copia antes de modificarla,
+ * así que reinsertar las claves con las que se construyó no la copia.
+ */
+void TransitionTable::insert(size_t state, const std::vector<char>& symbols, int32_t index) {
+  std::vector<uint32_t> tapes;
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    if (symbols[i] != Transition::kWildcard || codes_[static_cast<unsigned char>(symbols[i])] >= 0) {
+      tapes.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  if (tapes.size() < num_tapes_) {
+    insertPattern(state, symbols, std::move(tapes), index);
+    return;
+  }
+
+  if (packed_) {
+    uint64_t key;
+    if (!packKey(state, symbols.data(), nullptr, key)) {
+      return;
+    }
+    if (dense_) {
+      if (dense_data_[key] != kNoTransition) {
+        return;
+      }
+      if (dense_table_.empty()) {
+        dense_table_.assign(dense_data_, dense_data_ + getDenseSize());
+        dense_data_ = dense_table_.data();
+      }
+      dense_table_[key] = index;
+    } else {
+      packed_table_.emplace(key, index);
+    }
+  } else {
+    wide_table_.emplace(wideKey(state, symbols.data(), nullptr), index);
+  }
+}
+
+/**
+ * @brief Inserta una transición con comodines en la tabla de su patrón
+ * @param state Índice del estado actual
+ * @param symbols Símbolos leídos
+ * @param tapes Cintas con símbolo concreto
+ * @param index Índice de la transición en δ
+ */
+void TransitionTable::insertPattern(size_t state, const std::vector<char>& symbols, std::vector<uint32_t> tapes,
+                                    int32_t index) {
+  auto it = std::find_if(patterns_.begin(), patterns_.end(),
+                         [&tapes](const Pattern& pattern) { return pattern.tapes == tapes; });
+  if (it == patterns_.end()) {
+    size_t wildcards = num_tapes_ - tapes.size();
+    it = std::upper_bound(patterns_.begin(), patterns_.end(), wildcards,
+                          [](size_t count, const Pattern& pattern) { return count < pattern.wildcards; });
+    TransitionTable table(num_states_, codes_, radix_, tapes.size());
+    it = patterns_.insert(it, Pattern{std::move(tapes), wildcards, std::move(table)});
+  }
+
+  std::vector<char> projected;
+  for (uint32_t tape : it->tapes) {
+    projected.push_back(symbols[tape]);
+  }
+  it->table.insert(state, projected, index);
+}
+
+/**
+ * @brief Busca la transición con comodines aplicable cuando no hay ninguna exacta
+ * @param state Índice del estado actual
+ * @param symbols Puntero a los num_tapes símbolos leídos
+ * @return Transición del patrón con menos comodines (la primera definida si hay varias), o kNoTransition
+ */
+int32_t TransitionTable::findPattern(size_t state, const char* symbols) const {
+  int32_t found = kNoTransition;
+  size_t found_wildcards = 0;
+  for (const Pattern& pattern : patterns_) {
+    if (found != kNoTransition && pattern.wildcards > found_wildcards) {
+      break;
+    }
+    int32_t index = pattern.table.findExact(state, symbols, pattern.tapes.data());
+    if (index != kNoTransition && (found == kNoTransition || index < found)) {
+      found = index;
+      found_wildcards = pattern.wildcards;
+    }
+  }
+  return found;
+}
+
+/**
+ * @brief Búsqueda para máquinas cuyo espacio de claves no cabe en 64 bits
+ * @param state Índice del estado actual
+ * @param symbols Puntero a los símbolos leídos
+ * @param tapes Cintas cuyos símbolos forman la clave (nullptr para las num_tapes primeras)
+ * @return Índice de la transición en δ, o kNoTransition si no existe
+ */
+int32_t TransitionTable::findWide(size_t state, const char* symbols, const uint32_t* tapes) const {
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    if (codes_[static_cast<unsigned char>(symbols[tapes == nullptr ? i : tapes[i]])] < 0) {
+      return kNoTransition;
+    }
+  }
+  auto it = wide_table_.find(wideKey(state, symbols, tapes));
+  return it == wide_table_.end() ? kNoTransition : it->second;
+}
+
+/**
+ * @brief Indica si la tabla usa acceso directo (tabla densa)
+ * @return true si es densa, false si usa tabla hash
+ */
+bool TransitionTable::isDense() const {
+  return dense_;
+}
+
+/**
+ * @brief Obtiene el número de entradas de la tabla densa
+ * @return |Q|·|Γ|^k si la tabla es densa, 0 en otro caso
+ */
+size_t TransitionTable::getDenseSize() const {
+  if (!dense_) {
+    return 0;
+  }
+  size_t total = num_states_ == 0 ? 1 : num_states_;
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    total *= radix_;
+  }
+  return total;
+}
+
+/**
+ * @brief Obtiene las entradas de la tabla densa
+ * @return Puntero a getDenseSize() entradas (nullptr si la tabla no es densa)
+ */
+const int32_t* TransitionTable::getDenseData() const {
+  return dense_ ? dense_data_ : nullptr;
+}
+
+/**
+ * @brief Obtiene el número de patrones de comodines distintos
+ * @return Número de tablas de patrón
+ */
+size_t TransitionTable::getNumPatterns() const {
+  return patterns_.size();
+}
+
+/**
+ * @brief Obtiene el número de entradas de la tabla, incluidas las de los patrones
+ * @return Entradas de la tabla densa o claves de la tabla hash, sumadas a las de cada patrón
+ */
+size_t TransitionTable::getNumEntries() const {
+  size_t entries = dense_ ? getDenseSize() : packed_table_.size() + wide_table_.size();
+  for (const Pattern& pattern : patterns_) {
+    entries += pattern.table.getNumEntries();
+  }
+  return entries;
+}
+
+/**
+ * @brief Construye la clave para máquinas cuyo espacio de claves no cabe en 64 bits
+ * @param state Índice del estado
+ * @param symbols Símbolos leídos
+ * @param tapes Cintas cuyos símbolos forman la clave (nullptr para las num_tapes primeras)
+ * @return Bytes del estado seguidos de los símbolos
+ */
+std::string TransitionTable::wideKey(size_t state, const char* symbols, const uint32_t* tapes) const {
+  std::string key(reinterpret_cast<const char*>(&state), sizeof(state));
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    key += symbols[tapes == nullptr ? i : tapes[i]];
+  }
+  return key;
+}
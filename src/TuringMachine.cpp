@@ -1,7 +1,23 @@
 #include "../include/TuringMachine.hpp"
+#include "../include/CycleDetector.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Aplica f(0), f(1), ..., f(N - 1) desenrollado en tiempo de compilación
+ */
+template <typename F, size_t... I>
+inline void forEachTape(F&& f, std::index_sequence<I...>) {
+  (f(I), ...);
+}
+
+}  // namespace
 
 /**
  * @brief Constructor de la Máquina de Turing multicinta
@@ -28,9 +44,17 @@ TuringMachine::TuringMachine(const std::set<std::string>& states,
     blank_symbol_(blank_symbol),
     final_states_(final_states),
     num_tapes_(num_tapes),
-    current_state_(initial_state),
+    transitions_pending_(false),
+    program_dirty_(true),
+    macro_block_size_(0),
+    detect_cycles_(false),
+    trace_open_(false),
+    current_state_(0),
     step_count_(0),
-    halted_(false) {
+    halted_(false),
+    status_(RunStatus::STEP_LIMIT),
+    cycle_period_(0),
+    run_loop_(nullptr) {
   
   if (states_.empty()) {
     throw std::invalid_argument("El conjunto de estados no puede estar vacío");
@@ -50,6 +74,10 @@ TuringMachine::TuringMachine(const std::set<std::string>& states,
     throw std::invalid_argument("El símbolo blanco debe pertenecer a Γ");
   }
   
+  if (input_alphabet_.contains(blank_symbol_)) {
+    throw std::invalid_argument("El símbolo blanco no puede pertenecer al alfabeto de entrada Σ");
+  }
+  
   if (num_tapes_ < 1) {
     throw std::invalid_argument("Debe haber al menos una cinta");
   }
@@ -57,6 +85,53 @@ TuringMachine::TuringMachine(const std::set<std::string>& states,
   for (size_t i = 0; i < num_tapes_; ++i) {
     tapes_.emplace_back(blank_symbol_);
   }
+  
+  selectRunLoop();
+  compile();
+  current_state_ = program_->getInitialState();
+}
+
+/**
+ * @brief Constructor a partir de una máquina ya compilada (imagen binaria)
+ * @param program Máquina compilada
+ * @param input_alphabet Alfabeto de entrada Σ
+ * @param tape_alphabet Alfabeto de cinta Γ
+ *
+ * No vuelve a validar la definición: el programa procede de una máquina ya validada. Las
+ * transiciones en forma de Transition solo se reconstruyen si se añade una nueva o se recompila.
+ */
+TuringMachine::TuringMachine(std::shared_ptr<const CompiledMachine> program, const Alphabet& input_alphabet,
+                             const Alphabet& tape_alphabet)
+  : input_alphabet_(input_alphabet),
+    tape_alphabet_(tape_alphabet),
+    initial_state_(program->getStateName(program->getInitialState())),
+    blank_symbol_(program->getBlankSymbol()),
+    num_tapes_(program->getNumTapes()),
+    transitions_pending_(true),
+    program_(std::move(program)),
+    program_dirty_(false),
+    macro_block_size_(0),
+    detect_cycles_(false),
+    trace_open_(false),
+    current_state_(program_->getInitialState()),
+    step_count_(0),
+    halted_(false),
+    status_(RunStatus::STEP_LIMIT),
+    cycle_period_(0),
+    run_loop_(nullptr) {
+  
+  for (uint32_t state = 0; state < program_->getNumStates(); ++state) {
+    states_.insert(states_.end(), program_->getStateName(state));
+    if (program_->isFinal(state)) {
+      final_states_.insert(final_states_.end(), program_->getStateName(state));
+    }
+  }
+  
+  for (size_t i = 0; i < num_tapes_; ++i) {
+    tapes_.emplace_back(blank_symbol_);
+  }
+  
+  selectRunLoop();
 }
 
 /**
@@ -65,6 +140,8 @@ TuringMachine::TuringMachine(const std::set<std::string>& states,
  * @throws std::invalid_argument si la transición es inválida
  */
 void TuringMachine::addTransition(const Transition& transition) {
+  restoreTransitions();
+  
   if (states_.find(transition.getCurrentState()) == states_.end()) {
     throw std::invalid_argument(
       "El estado actual de la transición debe pertenecer a Q"
@@ -83,8 +160,9 @@ void TuringMachine::addTransition(const Transition& transition) {
     );
   }
   
+  // El comodín solo es válido si no es un símbolo de Γ (en ese caso es un símbolo más)
   for (char symbol : transition.getReadSymbols()) {
-    if (!tape_alphabet_.contains(symbol)) {
+    if (!tape_alphabet_.contains(symbol) && symbol != Transition::kWildcard) {
       throw std::invalid_argument(
         "Los símbolos leídos deben pertenecer a Γ"
       );
@@ -92,23 +170,138 @@ void TuringMachine::addTransition(const Transition& transition) {
   }
   
   for (char symbol : transition.getWriteSymbols()) {
-    if (!tape_alphabet_.contains(symbol)) {
+    if (!tape_alphabet_.contains(symbol) && symbol != Transition::kWildcard) {
       throw std::invalid_argument(
         "Los símbolos escritos deben pertenecer a Γ"
       );
     }
   }
+  
+  transitions_.push_back(transition);
+  program_dirty_ = true;
+}
+
+/**
+ * @brief Compila la máquina a su representación intermedia (estados internados y δ plana)
+ *
+ * Se invoca tras el parseo de la definición; run() también la invoca si se han añadido
+ * transiciones desde la última compilación. Los identificadores de estado no cambian entre
+ * compilaciones porque dependen solo de Q.
+ */
+void TuringMachine::compile() {
+  restoreTransitions();
+  program_ = std::make_shared<const CompiledMachine>(states_, tape_alphabet_, initial_state_, blank_symbol_,
+                                                     final_states_, num_tapes_, transitions_);
+  program_dirty_ = false;
+  macro_.reset();
+  if (profile_) {
+    profile_.emplace(program_);
+  }
+}
 
-  // Comprobación de que el símbolo blanco no está incluido en el alfabeto de entrada
+/**
+ * @brief Activa o desactiva la simulación por macro-máquina
+ * @param block_size Número de celdas por bloque (0 desactiva el modo macro)
+ * @throws std::invalid_argument si el tamaño de bloque supera MacroEngine::kMaxBlockSize
+ */
+void TuringMachine::setMacroBlockSize(size_t block_size) {
+  if (block_size > MacroEngine::kMaxBlockSize) {
+    throw std::invalid_argument(
+      "El tamaño de bloque debe estar entre 1 y " + std::to_string(MacroEngine::kMaxBlockSize)
+    );
+  }
+  macro_block_size_ = block_size;
+  macro_.reset();
+}
+
+/**
+ * @brief Elige el almacenamiento de una cinta
+ * @param tape Índice de la cinta
+ * @param storage Almacenamiento a usar
+ * @throws std::out_of_range si la cinta no existe
+ *
+ * La cinta empaquetada codifica los símbolos de Γ y de Σ (la definición no obliga a que Σ ⊆ Γ).
+ */
+void TuringMachine::setTapeStorage(size_t tape, TapeStorage storage) {
+  if (tape >= num_tapes_) {
+    throw std::out_of_range("La máquina no tiene la cinta " + std::to_string(tape));
+  }
+  Alphabet symbols = tape_alphabet_;
   for (char symbol : input_alphabet_.getSymbols()) {
-    if (symbol == blank_symbol_) {
-      throw std::invalid_argument(
-        "El símbolo blanco no puede pertenecer al alfabeto de entrada Σ"
-      );
+    symbols.addSymbol(symbol);
+  }
+  tapes_[tape].setStorage(storage, symbols);
+}
+
+/**
+ * @brief Activa o desactiva la detección de configuraciones repetidas
+ * @param enabled true para detener las ejecuciones que repiten una configuración
+ *
+ * Con la detección activa, una ejecución que no se detiene termina con RunStatus::NON_HALTING
+ * en cuanto se demuestra el ciclo, sin consumir el límite de pasos.
+ */
+void TuringMachine::setCycleDetection(bool enabled) {
+  detect_cycles_ = enabled;
+  selectRunLoop();
+}
+
+/**
+ * @brief Activa o desactiva el perfilado de las ejecuciones
+ * @param enabled true para acumular un ExecutionProfile en cada run()
+ *
+ * Activarlo crea un perfil vacío; los contadores se acumulan en todas las ejecuciones hasta que
+ * se desactiva o se recompila la máquina. Con el perfil activo la máquina se ejecuta siempre
+ * paso a paso (sin macro-máquina ni bucles de barrido), de modo que cada paso queda contado.
+ * Desactivado no tiene ningún coste: el bucle de ejecución sin perfil no contiene sus contadores.
+ */
+void TuringMachine::setProfiling(bool enabled) {
+  if (enabled) {
+    profile_.emplace(program_);
+  } else {
+    profile_.reset();
+  }
+  selectRunLoop();
+}
+
+/**
+ * @brief Activa o desactiva la traza binaria de las ejecuciones
+ * @param path Fichero de traza (vacío para desactivarla)
+ * @throws std::runtime_error si el fichero no se puede crear
+ *
+ * Cada run() añade al fichero la cadena de entrada, un registro por transición aplicada y el
+ * resultado (ver TraceWriter); la herramienta mt_trace reconstruye con ella la traza legible.
+ * Las copias de la máquina comparten el fichero, así que solo deben trazarse desde un hilo.
+ * Con la traza activa la máquina se ejecuta siempre paso a paso, como al perfilarla.
+ */
+void TuringMachine::setTraceFile(const std::string& path) {
+  trace_.reset();
+  trace_open_ = false;
+  if (!path.empty()) {
+    if (program_dirty_) {
+      compile();
     }
+    trace_ = std::make_shared<TraceWriter>(path, *program_);
+  }
+  selectRunLoop();
+}
+
+/**
+ * @brief Elige entre el ejecutor determinista y la búsqueda no determinista
+ * @param mode DETERMINISTIC (por defecto), BREADTH_FIRST o ITERATIVE_DEEPENING
+ * @param jobs Hilos de la búsqueda
+ * @param memory_limit Memoria máxima estimada de la búsqueda en bytes
+ *
+ * El ejecutor determinista aplica siempre la primera transición definida para cada estado y
+ * símbolos leídos. En los modos de búsqueda run() explora todas (ver NondeterministicSearch),
+ * sin macro-máquina, detección de ciclos, perfil ni traza, y advance() no está disponible. Las
+ * copias de la máquina comparten la búsqueda, así que solo deben ejecutarse desde un hilo.
+ */
+void TuringMachine::setSearchMode(SearchMode mode, size_t jobs, size_t memory_limit) {
+  if (mode == SearchMode::DETERMINISTIC) {
+    search_.reset();
+  } else {
+    search_ = std::make_shared<NondeterministicSearch>(mode, jobs, memory_limit);
   }
-  
-  transitions_.push_back(transition);
 }
 
 /**
@@ -116,46 +309,134 @@ void TuringMachine::addTransition(const Transition& transition) {
  * @param input Cadena de entrada
  * @param max_steps Número máximo de pasos antes de abortar
  * @return true si la ejecución terminó (con o sin aceptación), false si se excedió max_steps o si no hay transición aplicable
+ *
+ * Equivale a load(input) seguido de advance(max_steps). En modo no determinista (ver
+ * setSearchMode) la máquina queda en la configuración de la rama que da el resultado.
  */
-bool TuringMachine::run(const std::string& input, size_t max_steps) {
-  for (char c : input) {
-    if (!input_alphabet_.contains(c)) {
-      throw std::invalid_argument(
-        "La cadena de entrada contiene símbolos que no pertenecen a Σ"
-      );
+bool TuringMachine::run(std::string_view input, size_t max_steps) {
+  load(input);
+  if (search_) {
+    SearchResult result = search_->run(*program_, input, max_steps);
+    for (size_t i = 0; i < num_tapes_; ++i) {
+      tapes_[i].load(result.tapes[i], result.heads[i]);
     }
+    current_state_ = result.state;
+    step_count_ = result.steps;
+    status_ = result.status;
+    halted_ = status_ == RunStatus::HALTED;
+    cycle_period_ = result.cycle_period;
+    return halted_;
+  }
+  advance(max_steps);
+  if (trace_open_) {
+    trace_->endRun(step_count_, status_, current_state_);
+    trace_open_ = false;
+  }
+  return halted_;
+}
+
+/**
+ * @brief Prepara una ejecución: cinta con la entrada, estado inicial y contadores a cero
+ * @param input Cadena de entrada
+ * @throws std::invalid_argument si la cadena contiene símbolos que no pertenecen a Σ
+ *
+ * La ejecución avanza después con advance(). Si la traza está activa y la ejecución anterior
+ * no había terminado, su registro se cierra con los pasos ejecutados hasta ahora.
+ */
+void TuringMachine::load(std::string_view input) {
+  if (!input_alphabet_.containsAll(input)) {
+    throw std::invalid_argument(
+      "La cadena de entrada contiene símbolos que no pertenecen a Σ"
+    );
+  }
+  
+  if (program_dirty_) {
+    compile();
+  }
+  if (trace_open_) {
+    trace_->endRun(step_count_, status_, current_state_);
+    trace_open_ = false;
   }
   
   initializeTapes(input);
-  current_state_ = initial_state_;
+  current_state_ = program_->getInitialState();
   step_count_ = 0;
   halted_ = false;
+  status_ = RunStatus::STEP_LIMIT;
+  cycle_period_ = 0;
   
-  // Descomentar esta parte si quieres activar el modo traza
-  // Imprimir configuración inicial
-  // std::cout << "\n╔════════════════════════════════════════════════════╗\n";
-  // std::cout << "║           TRAZA DE EJECUCIÓN - MT                  ║\n";
-  // std::cout << "╚════════════════════════════════════════════════════╝\n\n";
-  // printTrace();
-  
-  while (!halted_ && step_count_ < max_steps) {
-    if (!executeStep()) {
-      halted_ = true;
+  // La traza de la ejecución se guarda con setTraceFile() y se imprime con la herramienta mt_trace
+  if (trace_) {
+    trace_->beginRun(input, current_state_);
+    trace_open_ = true;
+  }
+  if (profile_) {
+    profile_->beginRun();
+  }
+}
+
+/**
+ * @brief Avanza la ejecución en curso como mucho steps pasos
+ * @param steps Pasos a ejecutar en esta llamada
+ * @return ACCEPTED o HALTED si la máquina se detuvo, NON_HALTING si repitió una configuración
+ *         y BUDGET_EXHAUSTED si ejecutó los steps pasos sin terminar
+ * @throws std::logic_error si la traza está activa y la ejecución no empezó con load(), o si la
+ *         máquina está en modo no determinista
+ *
+ * La ejecución puede avanzar por tramos: load(input) seguido de advance(a) y advance(b) cuenta
+ * los mismos pasos y llega a la misma configuración que run(input, a + b), sin repetir nada. Una
+ * vez terminada, advance() solo devuelve el resultado. También continúa la configuración
+ * restaurada de un punto de control (ver Checkpoint). Con la detección de ciclos activa, la
+ * búsqueda de configuraciones repetidas empieza de nuevo en cada llamada; con la macro-máquina,
+ * cada llamada construye su caché, así que conviene avanzar tramos largos.
+ */
+StepStatus TuringMachine::advance(size_t steps) {
+  if (search_) {
+    throw std::logic_error("La búsqueda no determinista solo se ejecuta con run()");
+  }
+  if (!halted_ && status_ == RunStatus::STEP_LIMIT) {
+    if (trace_ && !trace_open_) {
+      throw std::logic_error("La ejecución trazada debe empezar con load()");
+    }
+    if (program_dirty_) {
+      compile();
+    }
+    const size_t kNoLimit = std::numeric_limits<size_t>::max();
+    execute(steps < kNoLimit - step_count_ ? step_count_ + steps : kNoLimit);
+    if (trace_open_ && status_ != RunStatus::STEP_LIMIT) {
+      trace_->endRun(step_count_, status_, current_state_);
+      trace_open_ = false;
     }
-    step_count_++;
   }
   
-  // Imprimir configuración final
-  // if (halted_) {
-  //   std::cout << "\n╔════════════════════════════════════════════════════╗\n";
-  //   std::cout << "║           CONFIGURACIÓN FINAL                      ║\n";
-  //   std::cout << "╚════════════════════════════════════════════════════╝\n\n";
-  //   std::cout << "Estado final: " << current_state_ << "\n";
-  //   std::cout << "Total de pasos: " << step_count_ << "\n";
-  //   std::cout << "Resultado: " << (isAccepted() ? "ACEPTADA" : "RECHAZADA") << "\n\n";
-  // }
-  
-  return halted_;
+  switch (status_) {
+    case RunStatus::HALTED:
+      return isAccepted() ? StepStatus::ACCEPTED : StepStatus::HALTED;
+    case RunStatus::NON_HALTING:
+      return StepStatus::NON_HALTING;
+    case RunStatus::STEP_LIMIT:
+    case RunStatus::MEMORY_LIMIT:
+      break;
+  }
+  return StepStatus::BUDGET_EXHAUSTED;
+}
+
+/**
+ * @brief Ejecuta pasos desde la configuración actual hasta detenerse o alcanzar max_steps
+ * @param max_steps Número máximo de pasos de toda la ejecución
+ */
+void TuringMachine::execute(size_t max_steps) {
+  if (macro_block_size_ > 0 && !profile_ && !trace_) {
+    if (!macro_) {
+      macro_.emplace(*program_, macro_block_size_);
+    }
+    halted_ = macro_->run(tapes_, current_state_, step_count_, max_steps);
+  } else {
+    (this->*run_loop_)(max_steps);
+  }
+  if (halted_) {
+    status_ = RunStatus::HALTED;
+  }
 }
 
 /**
@@ -163,7 +444,7 @@ bool TuringMachine::run(const std::string& input, size_t max_steps) {
  * @return true si el estado actual es un estado final
  */
 bool TuringMachine::isAccepted() const {
-  return final_states_.find(current_state_) != final_states_.end();
+  return program_->isFinal(current_state_);
 }
 
 /**
@@ -171,7 +452,7 @@ bool TuringMachine::isAccepted() const {
  * @return Estado actual
  */
 std::string TuringMachine::getCurrentState() const {
-  return current_state_;
+  return program_->getStateName(current_state_);
 }
 
 /**
@@ -180,8 +461,9 @@ std::string TuringMachine::getCurrentState() const {
  */
 std::vector<std::string> TuringMachine::getTapesContent() const {
   std::vector<std::string> contents;
+  contents.reserve(tapes_.size());
   for (const auto& tape : tapes_) {
-    contents.push_back(tape.getContent());
+    contents.emplace_back(tape.getView());
   }
   return contents;
 }
@@ -192,12 +474,22 @@ std::vector<std::string> TuringMachine::getTapesContent() const {
  */
 std::vector<std::string> TuringMachine::getTapesContentWithHead() const {
   std::vector<std::string> contents;
+  contents.reserve(tapes_.size());
   for (const auto& tape : tapes_) {
     contents.push_back(tape.getContentWithHead());
   }
   return contents;
 }
 
+/**
+ * @brief Obtiene una cinta, para consultar su contenido con vistas sin copiarlo
+ * @param index Número de la cinta (desde 0)
+ * @return Cinta
+ */
+const Tape& TuringMachine::getTape(size_t index) const {
+  return tapes_.at(index);
+}
+
 /**
  * @brief Obtiene el número de pasos ejecutados
  * @return Número de pasos
@@ -206,13 +498,63 @@ size_t TuringMachine::getStepCount() const {
   return step_count_;
 }
 
+/**
+ * @brief Obtiene el número de cintas de la máquina
+ * @return Número de cintas
+ */
+size_t TuringMachine::getNumTapes() const {
+  return num_tapes_;
+}
+
+/**
+ * @brief Obtiene el alfabeto de entrada
+ * @return Alfabeto de entrada Σ
+ */
+const Alphabet& TuringMachine::getInputAlphabet() const {
+  return input_alphabet_;
+}
+
+/**
+ * @brief Obtiene la máquina compilada
+ * @return Programa de la última compilación (compartido con las copias de la máquina)
+ */
+std::shared_ptr<const CompiledMachine> TuringMachine::getProgram() const {
+  return program_;
+}
+
+/**
+ * @brief Obtiene el perfil acumulado de las ejecuciones
+ * @return Perfil, o nullptr si el perfilado no está activo
+ */
+const ExecutionProfile* TuringMachine::getProfile() const {
+  return profile_ ? &*profile_ : nullptr;
+}
+
+/**
+ * @brief Obtiene cómo terminó la última ejecución
+ * @return HALTED, STEP_LIMIT o NON_HALTING
+ */
+RunStatus TuringMachine::getRunStatus() const {
+  return status_;
+}
+
+/**
+ * @brief Obtiene el periodo del ciclo detectado en la última ejecución
+ * @return Pasos entre dos apariciones de la configuración repetida (0 si no hubo ciclo)
+ */
+size_t TuringMachine::getCyclePeriod() const {
+  return cycle_period_;
+}
+
 /**
  * @brief Reinicia la máquina al estado inicial
  */
 void TuringMachine::reset() {
-  current_state_ = initial_state_;
+  current_state_ = program_->getInitialState();
   step_count_ = 0;
   halted_ = false;
+  status_ = RunStatus::STEP_LIMIT;
+  cycle_period_ = 0;
   
   for (auto& tape : tapes_) {
     tape.reset("");
@@ -223,7 +565,7 @@ void TuringMachine::reset() {
  * @brief Imprime la configuración actual de la máquina
  */
 void TuringMachine::printConfiguration() const {
-  std::cout << "Estado: " << current_state_ << "\n";
+  std::cout << "Estado: " << getCurrentState() << "\n";
   std::cout << "Pasos: " << step_count_ << "\n";
   
   for (size_t i = 0; i < tapes_.size(); ++i) {
@@ -239,19 +581,24 @@ void TuringMachine::printConfiguration() const {
  * @return Contenido de la primera cinta sin blancos en los extremos
  */
 std::string TuringMachine::getResultFromFirstTape() const {
+  return std::string(getResultViewFromFirstTape());
+}
+
+/**
+ * @brief Obtiene una vista del resultado de la primera cinta, sin copiarlo
+ * @return Contenido de la primera cinta sin blancos en los extremos (el blanco si está vacía),
+ *         válido hasta la siguiente ejecución
+ */
+std::string_view TuringMachine::getResultViewFromFirstTape() const {
   if (tapes_.empty()) {
-    return "";
+    return std::string_view();
   }
   
-  std::string content = tapes_[0].getContent();
-  
-  size_t start = content.find_first_not_of(blank_symbol_);
-  if (start == std::string::npos) {
-    return std::string(1, blank_symbol_);
+  std::string_view content = tapes_[0].getNonBlankView();
+  if (content.empty()) {
+    return std::string_view(&blank_symbol_, 1);
   }
-  
-  size_t end = content.find_last_not_of(blank_symbol_);
-  return content.substr(start, end - start + 1);
+  return content;
 }
 
 /**
@@ -261,7 +608,7 @@ std::string TuringMachine::getResultFromFirstTape() const {
 void TuringMachine::printTrace(const Transition* transition) const {
   std::cout << "────────────────────────────────────────────────────\n";
   std::cout << "Paso: " << step_count_ << "\n";
-  std::cout << "Estado: " << current_state_ << "\n";
+  std::cout << "Estado: " << getCurrentState() << "\n";
   
   // Mostrar las cintas con el cabezal
   for (size_t i = 0; i < tapes_.size(); ++i) {
@@ -280,69 +627,189 @@ void TuringMachine::printTrace(const Transition* transition) const {
 }
 
 /**
- * @brief Busca una transición aplicable al estado y símbolos actuales
- * @param state Estado actual
- * @param symbols Símbolos actuales en las cintas
- * @return Puntero a la transición encontrada, nullptr si no existe
- */
-const Transition* TuringMachine::findTransition(
-    const std::string& state, 
-    const std::vector<char>& symbols) const {
-  
-  for (const auto& transition : transitions_) {
-    if (transition.matches(state, symbols)) {
-      return &transition;
-    }
-  }
-  
-  return nullptr;
-}
-
-/**
- * @brief Ejecuta un paso de la máquina de Turing
- * @return true si se pudo ejecutar un paso, false si no hay transición aplicable
+ * @brief Bucle de ejecución especializado para N cintas
+ * @param max_steps Número máximo de pasos antes de abortar
+ *
+ * Con N > 0 los símbolos leídos se guardan en un array de tamaño fijo y las escrituras y
+ * movimientos se desenrollan en tiempo de compilación. N = 0 es la versión genérica, que usa
+ * un buffer reservado al cargar la máquina. Ninguna de las dos reserva memoria por paso.
+ *
+ * Las transiciones que son bucles de barrido (ver CompiledMachine::ScanLoop) avanzan de una vez
+ * todas las celdas de la racha y suman al contador un paso por celda recorrida.
+ *
+ * Con kDetectCycles cada escritura y movimiento actualiza además el hash del CycleDetector, y la
+ * ejecución se detiene con RunStatus::NON_HALTING al repetirse una configuración. Con kProfile cada
+ * paso se cuenta en el ExecutionProfile. La política Tracer recibe cada transición aplicada
+ * (NullTracer no hace nada y desaparece al compilar; BinaryTracer la escribe en la traza). En
+ * estos modos los barridos se ejecutan paso a paso para no saltarse ninguna comprobación,
+ * contador ni registro.
  */
-bool TuringMachine::executeStep() {
-  std::vector<char> current_symbols = readCurrentSymbols();
-  
-  const Transition* transition = findTransition(current_state_, current_symbols);
-  
-  if (transition == nullptr) {
-    return false;
+template <size_t N, bool kDetectCycles, bool kProfile, typename Tracer>
+void TuringMachine::runLoop(size_t max_steps) {
+  const CompiledMachine& program = *program_;
+  Tape* tapes = tapes_.data();
+  std::array<char, (N > 0 ? N : 1)> fixed_symbols;
+  char* symbols = N > 0 ? fixed_symbols.data() : symbols_.data();
+  
+  CycleDetector detector(blank_symbol_);
+  if (kDetectCycles) {
+    detector.start(current_state_, tapes, num_tapes_);
   }
-  
-  current_state_ = transition->getNextState();
-  
-  const std::vector<char>& write_symbols = transition->getWriteSymbols();
-  const std::vector<Movement>& movements = transition->getMovements();
-  
-  for (size_t i = 0; i < num_tapes_; ++i) {
-    tapes_[i].write(write_symbols[i]);
+  ExecutionProfile* profile = kProfile ? &*profile_ : nullptr;
+  Tracer tracer(trace_.get());
+  
+  auto apply = [&](int32_t transition, size_t i) {
+    char symbol = program.getWriteSymbol(transition, i, symbols[i]);
+    Movement movement = program.getMovement(transition, i);
+    if (kDetectCycles) {
+      detector.write(i, symbols[i], symbol);
+      detector.move(i, movement);
+    }
+    size_t old_size = 0;
+    int old_head = 0;
+    if (kProfile) {
+      old_size = tapes[i].getSize();
+      old_head = tapes[i].getHeadPosition();
+    }
+    
+    tapes[i].write(symbol);
     
-    switch (movements[i]) {
+    switch (movement) {
       case Movement::LEFT:
-        tapes_[i].moveLeft();
+        tapes[i].moveLeft();
         break;
       case Movement::RIGHT:
-        tapes_[i].moveRight();
+        tapes[i].moveRight();
         break;
       case Movement::STAY:
-        tapes_[i].moveStay();
+        tapes[i].moveStay();
         break;
     }
-  }
-  
-  // Imprimir traza después de aplicar la transición
-  // printTrace(transition);
+    
+    if (kProfile) {
+      profile->move(i, movement, old_size, old_head, tapes[i].getSize(), tapes[i].getHeadPosition());
+    }
+  };
   
-  return true;
+  while (!halted_ && step_count_ < max_steps) {
+    if (N > 0) {
+      forEachTape([&](size_t i) { symbols[i] = tapes[i].read(); }, std::make_index_sequence<N>());
+    } else {
+      for (size_t i = 0; i < num_tapes_; ++i) {
+        symbols[i] = tapes[i].read();
+      }
+    }
+    
+    int32_t transition = program.findTransition(current_state_, symbols);
+    if (kProfile) {
+      profile->step(current_state_, transition);
+    }
+    
+    if (transition == TransitionTable::kNoTransition) {
+      halted_ = true;
+    } else if (const CompiledMachine::ScanLoop* scan =
+                   kDetectCycles || kProfile || Tracer::kEnabled ? nullptr : program.getScanLoop(transition)) {
+      // Bucle de barrido: escrituras idénticas y un único cabezal que recorre la racha de una vez
+      if (N > 0) {
+        forEachTape([&](size_t i) { tapes[i].write(symbols[i]); }, std::make_index_sequence<N>());
+      } else {
+        for (size_t i = 0; i < num_tapes_; ++i) {
+          tapes[i].write(symbols[i]);
+        }
+      }
+      size_t limit = max_steps - step_count_;
+      if (scan->movement == Movement::LEFT) {
+        step_count_ += tapes[scan->tape].scanLeft(scan->symbols, limit);
+      } else {
+        step_count_ += tapes[scan->tape].scanRight(scan->symbols, limit);
+      }
+      continue;
+    } else {
+      tracer.step(program, transition, symbols);
+      current_state_ = program.getNextState(transition);
+      
+      if (N > 0) {
+        forEachTape([&](size_t i) { apply(transition, i); }, std::make_index_sequence<N>());
+      } else {
+        for (size_t i = 0; i < num_tapes_; ++i) {
+          apply(transition, i);
+        }
+      }
+    }
+    step_count_++;
+    
+    if (kDetectCycles && !halted_ && detector.check(current_state_, tapes)) {
+      status_ = RunStatus::NON_HALTING;
+      cycle_period_ = detector.getPeriod();
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Instancia del bucle de ejecución según la política de traza
+ */
+template <size_t N, bool kDetectCycles, bool kProfile>
+TuringMachine::RunLoop TuringMachine::selectTracer() const {
+  return trace_ ? &TuringMachine::runLoop<N, kDetectCycles, kProfile, BinaryTracer>
+                : &TuringMachine::runLoop<N, kDetectCycles, kProfile, NullTracer>;
+}
+
+/**
+ * @brief Instancia del bucle de ejecución de N cintas según la detección de ciclos, el perfilado y la traza
+ */
+template <size_t N>
+TuringMachine::RunLoop TuringMachine::selectRunLoopFor() const {
+  if (detect_cycles_) {
+    return profile_ ? selectTracer<N, true, true>() : selectTracer<N, true, false>();
+  }
+  return profile_ ? selectTracer<N, false, true>() : selectTracer<N, false, false>();
+}
+
+/**
+ * @brief Selecciona el bucle de ejecución según el número de cintas, la detección de ciclos, el perfilado y la traza
+ *
+ * Las máquinas de 1 a 4 cintas usan un bucle especializado; el resto, el genérico.
+ */
+void TuringMachine::selectRunLoop() {
+  switch (num_tapes_) {
+    case 1:
+      run_loop_ = selectRunLoopFor<1>();
+      break;
+    case 2:
+      run_loop_ = selectRunLoopFor<2>();
+      break;
+    case 3:
+      run_loop_ = selectRunLoopFor<3>();
+      break;
+    case 4:
+      run_loop_ = selectRunLoopFor<4>();
+      break;
+    default:
+      run_loop_ = selectRunLoopFor<0>();
+      symbols_.assign(num_tapes_, blank_symbol_);
+      break;
+  }
+}
+
+/**
+ * @brief Reconstruye δ como lista de Transition si la máquina se cargó de una imagen binaria
+ */
+void TuringMachine::restoreTransitions() {
+  if (!transitions_pending_) {
+    return;
+  }
+  for (size_t i = 0; i < program_->getNumTransitions(); ++i) {
+    transitions_.push_back(program_->getTransition(i));
+  }
+  transitions_pending_ = false;
 }
 
 /**
  * @brief Inicializa las cintas con la cadena de entrada
  * @param input Cadena de entrada (se coloca en la primera cinta)
  */
-void TuringMachine::initializeTapes(const std::string& input) {
+void TuringMachine::initializeTapes(std::string_view input) {
   for (size_t i = 0; i < num_tapes_; ++i) {
     if (i == 0) {
       tapes_[i].reset(input);
@@ -351,15 +818,3 @@ void TuringMachine::initializeTapes(const std::string& input) {
     }
   }
 }
-
-/**
- * @brief Lee los símbolos actuales de todas las cintas
- * @return Vector con el símbolo actual de cada cinta
- */
-std::vector<char> TuringMachine::readCurrentSymbols() const {
-  std::vector<char> symbols;
-  for (const auto& tape : tapes_) {
-    symbols.push_back(tape.read());
-  }
-  return symbols;
-}
@@ -1,60 +1,733 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
 #include <vector>
+#include "../include/BoundedQueue.hpp"
+#include "../include/Checkpoint.hpp"
 #include "../include/FileParser.hpp"
+#include "../include/MachineOptimizer.hpp"
+#include "../include/MappedInput.hpp"
+#include "../include/ResultWriter.hpp"
+#include "../include/ThreadPool.hpp"
 #include "../include/TuringMachine.hpp"
 
+/**
+ * @brief Opciones de la línea de comandos
+ */
+struct Options {
+  std::string definition_file;
+  std::string input_file;
+  size_t jobs = 1;
+  bool stream = false;
+  size_t macro_block_size = 0;
+  std::vector<TapeStorage> tape_storage;
+  size_t max_steps = 10000;
+  bool detect_cycles = false;
+  bool use_cache = true;
+  bool optimize = true;
+  bool merge_states = false;
+  std::string profile_file;
+  ProfileFormat profile_format = ProfileFormat::JSON;
+  std::string trace_file;
+  OutputFormat format = OutputFormat::TEXT;
+  unsigned fields = ResultWriter::kAllFields;
+  std::string checkpoint_file;
+  size_t checkpoint_every = 0;
+  std::string resume_file;
+  SearchMode search_mode = SearchMode::DETERMINISTIC;
+  size_t search_memory_mb = NondeterministicSearch::kDefaultMemoryLimit >> 20;
+};
+
+/**
+ * @brief Señal recibida (SIGTERM o SIGINT) mientras se guardan puntos de control
+ */
+volatile std::sig_atomic_t g_stop_signal = 0;
+
+/**
+ * @brief Manejador de SIGTERM y SIGINT: la ejecución se detiene al terminar el tramo en curso
+ */
+extern "C" void HandleStopSignal(int signal) {
+  g_stop_signal = signal;
+}
+
 /**
  * @brief Metodo que muestra el uso correcto del programa
  * @param program_name Nombre del ejecutable
  */
 void Usage(const std::string& program_name) {
-  std::cerr << "Uso: " << program_name << " <definition_file> <input_file>\n\n";
+  std::cerr << "Uso: " << program_name << " [opciones] <definition_file> <input_file>\n\n";
   std::cerr << "Argumentos:\n";
   std::cerr << "  definition_file  Archivo con la definición de la Máquina de Turing\n";
   std::cerr << "  input_file       Archivo con la cadena de entrada\n\n";
+  std::cerr << "Opciones:\n";
+  std::cerr << "  --jobs N         Ejecuta las cadenas en N hilos (por defecto 1)\n";
+  std::cerr << "  --stream         Procesa las cadenas a medida que se leen (input_file puede ser - o un FIFO)\n";
+  std::cerr << "  --macro K        Simula por macro-máquina con bloques de K celdas\n";
+  std::cerr << "  --tape-storage S Almacenamiento de las cintas: contiguous, rle o packed (uno para todas o uno por cinta, separados por comas)\n";
+  std::cerr << "  --max-steps N    Número máximo de pasos por cadena (por defecto 10000)\n";
+  std::cerr << "  --detect-cycles  Informa como no terminante una ejecución que repite una configuración\n";
+  std::cerr << "  --no-cache       No usa ni escribe la imagen binaria precompilada (<definition_file>.mtc)\n";
+  std::cerr << "  --no-optimize    No elimina los estados y transiciones muertos\n";
+  std::cerr << "  --merge-states   Fusiona además los estados equivalentes (se muestra el nombre del estado que los sustituye; no admite --no-optimize)\n";
+  std::cerr << "  --profile F      Guarda en F el perfil de ejecución (pasos por estado y transición, cabezales y crecimiento de las cintas)\n";
+  std::cerr << "  --profile-format Formato del perfil: json (por defecto), csv o folded (pilas plegadas para flame graphs)\n";
+  std::cerr << "  --format F       Formato de salida: text (por defecto), jsonl, csv o tsv\n";
+  std::cerr << "  --fields L       Campos de jsonl/csv/tsv separados por comas: index, input, status, accepted, steps, state, result (primera cinta sin blancos) y tapes (por defecto, todos)\n";
+  std::cerr << "  --trace F        Guarda en F la traza binaria de las ejecuciones (se lee con mt_trace F; no admite --jobs ni --stream)\n";
+  std::cerr << "  --checkpoint F   Guarda en F la configuración de la ejecución en curso al recibir SIGTERM o SIGINT\n";
+  std::cerr << "  --checkpoint-every N  Guarda además el punto de control cada N pasos (requiere --checkpoint)\n";
+  std::cerr << "  --resume F       Continúa la ejecución guardada en el punto de control F y sigue con las cadenas posteriores\n";
+  std::cerr << "                   (--checkpoint y --resume no admiten --jobs, --stream, --trace ni --detect-cycles)\n";
+  std::cerr << "  --ntm M          Ejecuta la máquina como no determinista explorando sus configuraciones: bfs (en anchura) o iddfs (profundidad iterativa)\n";
+  std::cerr << "                   (--jobs indica los hilos de la búsqueda; no admite --stream, --macro, --detect-cycles, --profile, --trace, --checkpoint ni --resume)\n";
+  std::cerr << "  --ntm-memory MB  Memoria máxima de la búsqueda no determinista en MiB (por defecto 1024)\n\n";
   std::cerr << "Ejemplo:\n";
   std::cerr << "  " << program_name << " data/Definitions/Ejemplo_MT.txt data/Inputs/input1.txt\n";
 }
 
+/**
+ * @brief Convierte el valor de una opción en un número
+ * @param value Texto del valor
+ * @param min Valor mínimo admitido
+ * @param result Número resultante
+ * @return true si el valor es un número entero >= min
+ */
+bool ParseNumber(const std::string& value, size_t min, size_t& result) {
+  if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  try {
+    result = std::stoull(value);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return result >= min;
+}
+
+/**
+ * @brief Convierte el valor de --tape-storage en la lista de almacenamientos
+ * @param value Lista separada por comas de "contiguous", "rle" o "packed"
+ * @param result Almacenamientos resultantes
+ * @return true si todos los elementos son válidos
+ */
+bool ParseTapeStorage(const std::string& value, std::vector<TapeStorage>& result) {
+  result.clear();
+  size_t start = 0;
+  while (start <= value.size()) {
+    size_t comma = value.find(',', start);
+    if (comma == std::string::npos) {
+      comma = value.size();
+    }
+    std::string name = value.substr(start, comma - start);
+    if (name == "contiguous") {
+      result.push_back(TapeStorage::CONTIGUOUS);
+    } else if (name == "rle") {
+      result.push_back(TapeStorage::RUN_LENGTH);
+    } else if (name == "packed") {
+      result.push_back(TapeStorage::PACKED);
+    } else {
+      return false;
+    }
+    start = comma + 1;
+  }
+  return true;
+}
+
+/**
+ * @brief Convierte el valor de --profile-format en el formato de exportación
+ * @param value "json", "csv" o "folded"
+ * @param result Formato resultante
+ * @return true si el formato es válido
+ */
+bool ParseProfileFormat(const std::string& value, ProfileFormat& result) {
+  if (value == "json") {
+    result = ProfileFormat::JSON;
+  } else if (value == "csv") {
+    result = ProfileFormat::CSV;
+  } else if (value == "folded") {
+    result = ProfileFormat::FOLDED;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Convierte el valor de --format en el formato de salida
+ * @param value "text", "jsonl", "csv" o "tsv"
+ * @param result Formato resultante
+ * @return true si el formato es válido
+ */
+bool ParseOutputFormat(const std::string& value, OutputFormat& result) {
+  if (value == "text") {
+    result = OutputFormat::TEXT;
+  } else if (value == "jsonl") {
+    result = OutputFormat::JSONL;
+  } else if (value == "csv") {
+    result = OutputFormat::CSV;
+  } else if (value == "tsv") {
+    result = OutputFormat::TSV;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Convierte el valor de --ntm en el modo de búsqueda
+ * @param value "bfs" o "iddfs"
+ * @param result Modo resultante
+ * @return true si el valor es válido
+ */
+bool ParseSearchMode(const std::string& value, SearchMode& result) {
+  if (value == "bfs") {
+    result = SearchMode::BREADTH_FIRST;
+  } else if (value == "iddfs") {
+    result = SearchMode::ITERATIVE_DEEPENING;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Analiza los argumentos de la línea de comandos
+ * @param argc Número de argumentos
+ * @param argv Argumentos
+ * @param options Opciones resultantes
+ * @return true si los argumentos son válidos
+ *
+ * Las opciones con valor admiten tanto "--opcion valor" como "--opcion=valor".
+ */
+bool ParseArguments(int argc, char **argv, Options& options) {
+  std::vector<std::string> positional;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.rfind("--", 0) != 0 || arg == "-") {
+      positional.push_back(arg);
+      continue;
+    }
+
+    if (arg == "--stream") {
+      options.stream = true;
+      continue;
+    }
+    if (arg == "--detect-cycles") {
+      options.detect_cycles = true;
+      continue;
+    }
+    if (arg == "--no-cache") {
+      options.use_cache = false;
+      continue;
+    }
+    if (arg == "--no-optimize") {
+      options.optimize = false;
+      continue;
+    }
+    if (arg == "--merge-states") {
+      options.merge_states = true;
+      continue;
+    }
+
+    std::string name = arg;
+    std::string value;
+    size_t equals = arg.find('=');
+    if (equals != std::string::npos) {
+      name = arg.substr(0, equals);
+      value = arg.substr(equals + 1);
+    } else if (i + 1 < argc) {
+      value = argv[++i];
+    } else {
+      return false;
+    }
+
+    bool valid = false;
+    if (name == "--jobs") {
+      valid = ParseNumber(value, 1, options.jobs);
+    } else if (name == "--macro") {
+      valid = ParseNumber(value, 1, options.macro_block_size);
+    } else if (name == "--tape-storage") {
+      valid = ParseTapeStorage(value, options.tape_storage);
+    } else if (name == "--max-steps") {
+      valid = ParseNumber(value, 1, options.max_steps);
+    } else if (name == "--profile") {
+      options.profile_file = value;
+      valid = !value.empty();
+    } else if (name == "--profile-format") {
+      valid = ParseProfileFormat(value, options.profile_format);
+    } else if (name == "--format") {
+      valid = ParseOutputFormat(value, options.format);
+    } else if (name == "--fields") {
+      valid = ResultWriter::parseFields(value, options.fields);
+    } else if (name == "--trace") {
+      options.trace_file = value;
+      valid = !value.empty();
+    } else if (name == "--checkpoint") {
+      options.checkpoint_file = value;
+      valid = !value.empty();
+    } else if (name == "--checkpoint-every") {
+      valid = ParseNumber(value, 1, options.checkpoint_every);
+    } else if (name == "--resume") {
+      options.resume_file = value;
+      valid = !value.empty();
+    } else if (name == "--ntm") {
+      valid = ParseSearchMode(value, options.search_mode);
+    } else if (name == "--ntm-memory") {
+      valid = ParseNumber(value, 1, options.search_memory_mb) &&
+              options.search_memory_mb <= (std::numeric_limits<size_t>::max() >> 20);
+    }
+    if (!valid) {
+      return false;
+    }
+  }
+
+  bool checkpoints = !options.checkpoint_file.empty() || !options.resume_file.empty();
+  bool search = options.search_mode != SearchMode::DETERMINISTIC;
+  if (positional.size() != 2 || (options.detect_cycles && options.macro_block_size > 0) ||
+      (search && (options.stream || options.macro_block_size > 0 || options.detect_cycles || checkpoints ||
+                  !options.profile_file.empty() || !options.trace_file.empty())) ||
+      (!options.trace_file.empty() && (options.stream || options.jobs > 1)) ||
+      (options.checkpoint_every > 0 && options.checkpoint_file.empty()) ||
+      (options.merge_states && !options.optimize) ||
+      (checkpoints && (options.stream || options.jobs > 1 || !options.trace_file.empty() || options.detect_cycles))) {
+    return false;
+  }
+  options.definition_file = positional[0];
+  options.input_file = positional[1];
+  return true;
+}
+
+/**
+ * @brief Informa por la salida de error de cuánto ha reducido la máquina la optimización
+ * @param report Informe de la optimización aplicada al cargar la máquina (no se informa si no eliminó nada)
+ */
+void ReportOptimization(const OptimizationReport& report) {
+  if (report.states_after == report.states_before && report.transitions_after == report.transitions_before) {
+    return;
+  }
+  std::cerr << "Optimización: " << report.states_before << " → " << report.states_after << " estados ("
+            << report.unreachable_states << " inalcanzables, " << report.merged_states << " fusionados), "
+            << report.transitions_before << " → " << report.transitions_after << " transiciones\n";
+}
+
+/**
+ * @brief Recoge el resultado de la ejecución que acaba de terminar
+ * @param tm Máquina
+ * @param writer Escritor de resultados (indica si hacen falta las cintas y el resultado)
+ * @param result Resultado a completar
+ */
+void CollectResult(const TuringMachine& tm, const ResultWriter& writer, RunResult& result) {
+  result.status = tm.getRunStatus();
+  result.cycle_period = tm.getCyclePeriod();
+  result.accepted = tm.isAccepted();
+  result.final_state = tm.getCurrentState();
+  result.steps = tm.getStepCount();
+  if (writer.wantsResult()) {
+    result.result.assign(tm.getResultViewFromFirstTape());
+  }
+  if (writer.wantsTapes()) {
+    result.tapes = tm.getTapesContentWithHead();
+  }
+}
+
+/**
+ * @brief Ejecuta la máquina sobre una cadena y recoge el resultado
+ * @param tm Máquina (contexto de ejecución) a usar
+ * @param input Cadena de entrada
+ * @param max_steps Número máximo de pasos
+ * @param writer Escritor de resultados (indica si hacen falta las cintas y el resultado)
+ * @return Resultado de la ejecución (con el mensaje de error si la cadena no es válida)
+ */
+RunResult RunInput(TuringMachine& tm, std::string_view input, size_t max_steps, const ResultWriter& writer) {
+  RunResult result;
+  try {
+    tm.run(input, max_steps);
+    CollectResult(tm, writer, result);
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  }
+  tm.reset();
+  return result;
+}
+
+/**
+ * @brief Localiza las líneas del fichero de entrada repartiendo el trabajo entre varios hilos
+ * @param input Fichero proyectado
+ * @param jobs Número de hilos
+ * @return Vistas sobre cada línea, en el orden del fichero
+ *
+ * El fichero se divide en jobs rangos alineados a líneas; cada hilo recorre el suyo y los
+ * resultados se concatenan en orden. No se copia el contenido de ninguna cadena.
+ */
+std::vector<std::string_view> SplitLines(const MappedInput& input, size_t jobs) {
+  std::vector<std::string_view> chunks = input.split(jobs);
+  std::vector<std::vector<std::string_view>> chunk_lines(chunks.size());
+  {
+    ThreadPool pool(jobs);
+    for (size_t c = 0; c < chunks.size(); ++c) {
+      pool.submit([&chunks, &chunk_lines, c](size_t) {
+        LineReader reader(chunks[c]);
+        std::string_view line;
+        while (reader.next(line)) {
+          chunk_lines[c].push_back(line);
+        }
+      });
+    }
+    pool.wait();
+  }
+
+  std::vector<std::string_view> lines;
+  for (auto& chunk : chunk_lines) {
+    lines.insert(lines.end(), chunk.begin(), chunk.end());
+  }
+  return lines;
+}
+
+/**
+ * @brief Ejecuta las cadenas en un pool de hilos con robo de trabajo
+ * @param tm Máquina parseada (cada hilo trabaja sobre una copia que comparte el programa compilado)
+ * @param inputs Cadenas de entrada (vistas sobre el fichero proyectado)
+ * @param jobs Número de hilos
+ * @param max_steps Número máximo de pasos por cadena
+ * @param writer Escritor de resultados
+ * @param profile Perfil en el que se suman los de todos los hilos (nullptr si no se perfila)
+ * @return Código de salida del programa
+ *
+ * El rango de cadenas se divide recursivamente: cada tarea encola la mitad derecha en la cola
+ * de su hilo y sigue con la izquierda, de modo que los hilos ociosos roban el trabajo pendiente
+ * y una cadena de larga duración no retiene al resto. Los resultados se imprimen en el orden
+ * original en cuanto están disponibles.
+ */
+int RunParallel(const TuringMachine& tm, const std::vector<std::string_view>& inputs, size_t jobs, size_t max_steps,
+                ResultWriter& writer, ExecutionProfile* profile) {
+  const size_t kGrain = 4;
+
+  std::vector<TuringMachine> contexts(jobs, tm);
+  std::vector<RunResult> results(inputs.size());
+  std::vector<char> ready(inputs.size(), 0);
+  std::mutex mutex;
+  std::condition_variable result_ready;
+  std::atomic<bool> cancelled(false);
+
+  ThreadPool pool(jobs);
+  std::function<void(size_t, size_t, size_t)> process = [&](size_t begin, size_t end, size_t worker) {
+    while (end - begin > kGrain) {
+      size_t middle = begin + (end - begin) / 2;
+      pool.submit([&process, middle, end](size_t w) { process(middle, end, w); });
+      end = middle;
+    }
+    for (size_t i = begin; i < end && !cancelled; ++i) {
+      RunResult result = RunInput(contexts[worker], inputs[i], max_steps, writer);
+      std::lock_guard<std::mutex> lock(mutex);
+      results[i] = std::move(result);
+      ready[i] = 1;
+      result_ready.notify_one();
+    }
+  };
+  if (!inputs.empty()) {
+    pool.submit([&process, &inputs](size_t w) { process(0, inputs.size(), w); });
+  }
+
+  int status = 0;
+  for (size_t i = 0; i < inputs.size() && status == 0; ++i) {
+    RunResult result;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      result_ready.wait(lock, [&] { return ready[i] != 0; });
+      result = std::move(results[i]);
+    }
+    if (!writer.write(i, inputs[i], result)) {
+      status = 1;
+      cancelled = true;
+    }
+  }
+
+  pool.wait();
+  if (profile != nullptr) {
+    for (const auto& context : contexts) {
+      profile->merge(*context.getProfile());
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief Elemento del flujo: cadena de entrada con su número de secuencia
+ */
+struct StreamItem {
+  size_t sequence = 0;
+  std::string input;
+  RunResult result;
+};
+
+/**
+ * @brief Procesa las cadenas a medida que se leen: lector → ejecutores → escritor ordenado
+ * @param tm Máquina parseada (cada ejecutor trabaja sobre una copia)
+ * @param input Flujo de entrada (una cadena por línea)
+ * @param jobs Número de hilos ejecutores
+ * @param max_steps Número máximo de pasos por cadena
+ * @param writer Escritor de resultados (lo usa solo la etapa escritora)
+ * @param profile Perfil en el que se suman los de todos los ejecutores (nullptr si no se perfila)
+ * @return Código de salida del programa
+ *
+ * Las etapas se comunican mediante colas acotadas sin bloqueos. El lector no se adelanta más
+ * de kWindow cadenas al escritor, así que la memoria usada es constante sin importar la longitud
+ * del flujo, y los resultados se imprimen (en orden) antes de que termine la entrada. Una cadena
+ * inválida se notifica en stderr sin detener el flujo.
+ */
+int RunStream(const TuringMachine& tm, std::istream& input, size_t jobs, size_t max_steps, ResultWriter& writer,
+              ExecutionProfile* profile) {
+  const size_t kQueueCapacity = 256;
+  const size_t kWindow = 1024;
+
+  BoundedQueue<StreamItem> pending(kQueueCapacity);
+  BoundedQueue<StreamItem> finished(kQueueCapacity);
+  std::atomic<size_t> written(0);
+  std::atomic<size_t> total(0);
+  std::atomic<bool> reader_done(false);
+  std::mutex profile_mutex;
+
+  std::thread reader([&] {
+    size_t sequence = 0;
+    std::string line;
+    Backoff backoff;
+    while (std::getline(input, line)) {
+      while (sequence >= written.load(std::memory_order_acquire) + kWindow) {
+        backoff.pause();
+      }
+      backoff.reset();
+      StreamItem item;
+      item.sequence = sequence++;
+      item.input = std::move(line);
+      pending.push(std::move(item));
+    }
+    total = sequence;
+    reader_done = true;
+  });
+
+  std::vector<std::thread> executors;
+  for (size_t w = 0; w < jobs; ++w) {
+    executors.emplace_back([&] {
+      TuringMachine context(tm);
+      StreamItem item;
+      Backoff backoff;
+      while (true) {
+        bool done = reader_done.load(std::memory_order_acquire);
+        if (pending.tryPop(item)) {
+          backoff.reset();
+          item.result = RunInput(context, item.input, max_steps, writer);
+          finished.push(std::move(item));
+        } else if (done) {
+          if (profile != nullptr) {
+            std::lock_guard<std::mutex> lock(profile_mutex);
+            profile->merge(*context.getProfile());
+          }
+          return;
+        } else {
+          backoff.pause();
+        }
+      }
+    });
+  }
+
+  // Escritor: reordena los resultados en una ventana circular de kWindow posiciones
+  int status = 0;
+  std::vector<StreamItem> window(kWindow);
+  std::vector<char> filled(kWindow, 0);
+  size_t next = 0;
+  StreamItem item;
+  Backoff backoff;
+  while (!reader_done.load(std::memory_order_acquire) || next < total.load()) {
+    if (!finished.tryPop(item)) {
+      writer.flush();
+      backoff.pause();
+      continue;
+    }
+    backoff.reset();
+    size_t slot = item.sequence % kWindow;
+    window[slot] = std::move(item);
+    filled[slot] = 1;
+    while (filled[next % kWindow]) {
+      StreamItem& ready = window[next % kWindow];
+      if (!writer.write(ready.sequence, ready.input, ready.result)) {
+        status = 1;
+      }
+      filled[next % kWindow] = 0;
+      written.store(++next, std::memory_order_release);
+    }
+  }
+  writer.flush();
+
+  reader.join();
+  for (auto& executor : executors) {
+    executor.join();
+  }
+  return status;
+}
+
+/**
+ * @brief Ejecuta las cadenas en orden guardando puntos de control de la ejecución en curso
+ * @param tm Máquina parseada
+ * @param input Fichero de entrada proyectado
+ * @param options Opciones (límite de pasos, punto de control, intervalo y punto a reanudar)
+ * @param writer Escritor de resultados
+ * @return Código de salida del programa (128 + la señal si se interrumpió)
+ *
+ * Cada cadena se ejecuta por tramos de como mucho kSlice pasos con TuringMachine::advance(), que
+ * cuenta los pasos exactamente igual que una sola llamada a run(). Entre tramos se comprueba si
+ * ha llegado SIGTERM o SIGINT (en ese caso se guarda el punto de control y se termina) y si toca
+ * el punto de control periódico. Antes de guardarlo se vuelca la salida, de modo que los
+ * resultados de las cadenas anteriores nunca se pierden. Con --resume se salta hasta la cadena
+ * guardada, se continúa su ejecución y se sigue con las posteriores. El punto de control se
+ * borra al terminar todas las cadenas.
+ */
+int RunCheckpointed(TuringMachine& tm, const MappedInput& input, const Options& options, ResultWriter& writer) {
+  const size_t kSlice = size_t(1) << 24;
+
+  size_t first = 0;
+  std::string resumed_input;
+  if (!options.resume_file.empty()) {
+    first = Checkpoint::read(options.resume_file, tm, resumed_input);
+  }
+  size_t slice = options.checkpoint_every > 0 ? std::min(options.checkpoint_every, kSlice) : kSlice;
+
+  LineReader reader(input.getData());
+  std::string_view line;
+  size_t i = 0;
+  for (; i < first && reader.next(line); ++i) {
+  }
+  int status = 0;
+  for (; status == 0 && reader.next(line); ++i) {
+    RunResult result;
+    try {
+      if (i == first && !options.resume_file.empty()) {
+        if (line != resumed_input) {
+          throw std::runtime_error("El punto de control no corresponde al fichero de entrada: " + options.resume_file);
+        }
+      } else {
+        tm.load(line);
+      }
+      size_t next_checkpoint = tm.getStepCount() + options.checkpoint_every;
+      StepStatus step_status = StepStatus::BUDGET_EXHAUSTED;
+      while (step_status == StepStatus::BUDGET_EXHAUSTED && tm.getStepCount() < options.max_steps) {
+        if (g_stop_signal != 0 && !options.checkpoint_file.empty()) {
+          writer.flush();
+          Checkpoint::write(options.checkpoint_file, tm, i, line);
+          std::cerr << "Ejecución interrumpida: punto de control guardado en " << options.checkpoint_file << "\n";
+          return 128 + g_stop_signal;
+        }
+        if (options.checkpoint_every > 0 && tm.getStepCount() >= next_checkpoint) {
+          writer.flush();
+          Checkpoint::write(options.checkpoint_file, tm, i, line);
+          next_checkpoint = tm.getStepCount() + options.checkpoint_every;
+        }
+        step_status = tm.advance(std::min(options.max_steps - tm.getStepCount(), slice));
+      }
+      CollectResult(tm, writer, result);
+    } catch (const std::exception& e) {
+      result.error = e.what();
+    }
+    tm.reset();
+    if (!writer.write(i, line, result)) {
+      status = 1;
+    }
+  }
+
+  if (i < first) {
+    throw std::runtime_error("El punto de control no corresponde al fichero de entrada: " + options.resume_file);
+  }
+  if (status == 0 && !options.checkpoint_file.empty()) {
+    std::remove(options.checkpoint_file.c_str());
+  }
+  return status;
+}
+
 int main(int argc, char **argv) {
-  if (argc != 3) {
+  Options options;
+  if (!ParseArguments(argc, argv, options)) {
     Usage(argv[0]);
     return 1;
   }
 
-  std::string definition_file = argv[1];
-  std::string input_file = argv[2];
-
   try {
-    TuringMachine tm = FileParser::parseMachineDefinition(definition_file);
-    std::vector<std::string> input_strings = FileParser::parseInputStrings(input_file);
+    OptimizationLevel optimization = !options.optimize     ? OptimizationLevel::NONE
+                                     : options.merge_states ? OptimizationLevel::MERGE_STATES
+                                                            : OptimizationLevel::DEAD_CODE;
+    OptimizationReport report;
+    TuringMachine tm = FileParser::loadMachineDefinition(options.definition_file, options.use_cache, optimization, &report);
+    ReportOptimization(report);
+    tm.setMacroBlockSize(options.macro_block_size);
+    tm.setCycleDetection(options.detect_cycles);
+    tm.setProfiling(!options.profile_file.empty());
+    tm.setTraceFile(options.trace_file);
+    tm.setSearchMode(options.search_mode, options.jobs, options.search_memory_mb << 20);
+    if (!options.tape_storage.empty()) {
+      if (options.tape_storage.size() != 1 && options.tape_storage.size() != tm.getNumTapes()) {
+        throw std::runtime_error("--tape-storage debe indicar un almacenamiento o uno por cinta");
+      }
+      for (size_t i = 0; i < tm.getNumTapes(); ++i) {
+        tm.setTapeStorage(i, options.tape_storage[options.tape_storage.size() == 1 ? 0 : i]);
+      }
+    }
 
-    for (size_t i = 0; i < input_strings.size(); ++i) {
-      const std::string& input = input_strings[i];
+    // Con --jobs o --stream cada hilo perfila su copia y los perfiles se suman en este
+    std::optional<ExecutionProfile> merged;
+    ExecutionProfile* profile = nullptr;
+    if (tm.getProfile() != nullptr && (options.stream || options.jobs > 1)) {
+      merged.emplace(*tm.getProfile());
+      profile = &*merged;
+    }
 
-      std::cout << "---------------------------------------------------\n";
-      std::cout << "Cadena de entrada #" << (i + 1) << ": \"" << input << "\"\n";
-      std::cout << "---------------------------------------------------\n\n";
+    ResultWriter writer(options.format, options.fields, tm.getNumTapes());
+    int status = 0;
+    if (options.stream) {
+      if (options.input_file == "-") {
+        status = RunStream(tm, std::cin, options.jobs, options.max_steps, writer, profile);
+      } else {
+        std::ifstream input(options.input_file);
+        if (!input.is_open()) {
+          throw std::runtime_error("No se pudo abrir el archivo de entrada: " + options.input_file);
+        }
+        status = RunStream(tm, input, options.jobs, options.max_steps, writer, profile);
+      }
+    } else {
+      MappedInput input(options.input_file);
 
-      bool finished = tm.run(input);
-      
-      if (!finished) {
-        std::cout << "La máquina excedió el número máximo de pasos\n\n";
+      if (!options.checkpoint_file.empty() || !options.resume_file.empty()) {
+        if (!options.checkpoint_file.empty()) {
+          std::signal(SIGTERM, HandleStopSignal);
+          std::signal(SIGINT, HandleStopSignal);
+        }
+        status = RunCheckpointed(tm, input, options, writer);
+      } else if (options.jobs > 1 && options.search_mode == SearchMode::DETERMINISTIC) {
+        status = RunParallel(tm, SplitLines(input, options.jobs), options.jobs, options.max_steps, writer,
+                             profile);
+      } else {
+        LineReader reader(input.getData());
+        std::string_view line;
+        for (size_t i = 0; reader.next(line) && status == 0; ++i) {
+          if (!writer.write(i, line, RunInput(tm, line, options.max_steps, writer))) {
+            status = 1;
+          }
+        }
       }
-      
-      std::cout << "Resultado: " << (tm.isAccepted() ? "ACEPTADA" : "RECHAZADA") << "\n";
-      std::cout << "Estado final: " << tm.getCurrentState() << "\n";
-      std::cout << "Pasos ejecutados: " << tm.getStepCount() << "\n\n";
-      
-      std::vector<std::string> tapes_content = tm.getTapesContentWithHead();
-      for (size_t j = 0; j < tapes_content.size(); ++j) {
-        std::cout << "Cinta " << (j + 1) << ": " << tapes_content[j] << "\n";
+    }
+
+    if (!options.profile_file.empty()) {
+      std::ofstream out(options.profile_file);
+      if (!out.is_open()) {
+        throw std::runtime_error("No se pudo escribir el perfil: " + options.profile_file);
       }
-      
-      std::cout << "\n";
-      tm.reset();
+      (profile != nullptr ? *profile : *tm.getProfile()).write(out, options.profile_format);
     }
+    return status;
 
   } catch (const std::exception& e) {
     std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,646 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+#include "../include/CompiledMachine.hpp"
+#include "../include/FileParser.hpp"
+#include "../include/MachineOptimizer.hpp"
+#include "../include/TuringMachine.hpp"
+
+/**
+ * @brief Compilador de definiciones a C++
+ *
+ * Lee una definición con FileParser y genera un programa C++ independiente que ejecuta solo esa
+ * máquina: cada estado es un bloque con etiqueta y cada estado elige su transición con un switch
+ * anidado sobre los símbolos leídos (uno por cinta), cuyas ramas escriben, mueven los cabezales y
+ * saltan directamente al bloque del estado siguiente. Las operaciones de la cinta se definen en el
+ * propio programa y se expanden en línea; los bucles de barrido usan SymbolSet (solo cabecera), la
+ * única dependencia del programa. No queda ninguna tabla de despacho ni índice de estado en el
+ * bucle de ejecución.
+ *
+ * El programa generado acepta el mismo fichero de entrada que `MT` (una cadena por línea) y la
+ * opción `--max-steps`, y escribe los mismos resultados que `MT` con el formato de texto. Como
+ * `MT`, elimina antes el código muerto con MachineOptimizer salvo que se indique `--no-optimize`,
+ * y fusiona los estados equivalentes si se indica `--merge-states`.
+ *
+ * Uso: mt_compile [--no-optimize | --merge-states] <definition_file> <output_file>
+ */
+
+namespace {
+
+/**
+ * @brief Literal C++ de un símbolo
+ */
+std::string CharLiteral(char symbol) {
+  unsigned char c = static_cast<unsigned char>(symbol);
+  if (c == '\'' || c == '\\') {
+    return std::string("'\\") + symbol + "'";
+  }
+  if (c >= 0x20 && c < 0x7F) {
+    return std::string("'") + symbol + "'";
+  }
+  const char* hex = "0123456789abcdef";
+  return std::string("'\\x") + hex[c >> 4] + hex[c & 0xF] + "'";
+}
+
+/**
+ * @brief Literal C++ de una cadena (con los bytes no imprimibles escapados en octal)
+ */
+std::string StringLiteral(const std::string& text) {
+  std::string literal = "\"";
+  for (char symbol : text) {
+    unsigned char c = static_cast<unsigned char>(symbol);
+    if (c == '"' || c == '\\') {
+      literal += '\\';
+      literal += symbol;
+    } else if (c >= 0x20 && c < 0x7F) {
+      literal += symbol;
+    } else {
+      literal += '\\';
+      literal += static_cast<char>('0' + (c >> 6));
+      literal += static_cast<char>('0' + ((c >> 3) & 7));
+      literal += static_cast<char>('0' + (c & 7));
+    }
+  }
+  return literal + "\"";
+}
+
+/**
+ * @brief Generador del programa C++ de una máquina compilada
+ */
+class NativeGenerator {
+public:
+  NativeGenerator(const CompiledMachine& program, const Alphabet& input_alphabet, const std::string& source)
+    : program_(program), input_alphabet_(input_alphabet), source_(source) {}
+
+  void write(std::ostream& out);
+
+private:
+  const CompiledMachine& program_;
+  const Alphabet& input_alphabet_;
+  std::string source_;
+  std::vector<std::vector<int32_t>> transitions_of_;
+  std::vector<std::string> scan_sets_;
+
+  void writeState(std::ostream& out, uint32_t state);
+  void writeSwitch(std::ostream& out, const std::vector<int32_t>& transitions, size_t tape,
+                   const std::string& indent);
+  void writeTransition(std::ostream& out, int32_t transition, const std::string& indent);
+  bool isWildcard(char symbol) const;
+  int32_t preferred(const std::vector<int32_t>& transitions) const;
+};
+
+// Partes fijas del programa generado
+
+const char* kPrologue = R"(#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "SymbolSet.hpp"
+
+namespace {
+
+)";
+
+const char* kRuntime = R"(
+/**
+ * @brief Cinta: buffer contiguo cuya parte usada es [begin_, end_); al alcanzar un extremo del
+ * buffer este duplica su capacidad hacia ese lado
+ */
+class Tape {
+public:
+  Tape() : buffer_(64, kBlank), begin_(32), end_(32), head_(32), origin_(32) {}
+
+  void reset(const char* input, size_t size) {
+    std::fill(buffer_.begin() + begin_, buffer_.begin() + end_, kBlank);
+    size_t length = std::max<size_t>(size, 1) + 2;
+    while (origin_ + length > buffer_.size()) {
+      buffer_.resize(buffer_.size() * 2, kBlank);
+    }
+    begin_ = origin_;
+    end_ = begin_ + length;
+    head_ = begin_ + 1;
+    std::copy(input, input + size, buffer_.begin() + head_);
+  }
+
+  char read() const { return buffer_[head_]; }
+
+  void write(char symbol) {
+    buffer_[head_] = symbol;
+    if (symbol != kBlank) {
+      if (head_ == begin_) {
+        expandLeft();
+      }
+      if (head_ == end_ - 1) {
+        expandRight();
+      }
+    }
+  }
+
+  void moveLeft() {
+    if (head_ == begin_) {
+      expandLeft();
+    }
+    head_--;
+  }
+
+  void moveRight() {
+    if (head_ == end_ - 1) {
+      expandRight();
+    }
+    head_++;
+  }
+
+  // Barridos: mover el cabezal mientras lea símbolos del conjunto (como Tape::scanLeft/scanRight)
+  size_t scanLeft(const SymbolSet& symbols, size_t limit) {
+    size_t moved = 0;
+    while (moved < limit) {
+      if (head_ == 0) {
+        growLeft();
+      }
+      size_t span = std::min(limit - moved, head_);
+      size_t count = symbols.spanBackward(buffer_.data() + head_, span);
+      head_ -= count;
+      moved += count;
+      if (count < span) {
+        break;
+      }
+    }
+    begin_ = std::min(begin_, head_);
+    return moved;
+  }
+
+  size_t scanRight(const SymbolSet& symbols, size_t limit) {
+    size_t moved = 0;
+    while (moved < limit) {
+      if (head_ == buffer_.size() - 1) {
+        buffer_.resize(buffer_.size() * 2, kBlank);
+      }
+      size_t span = std::min(limit - moved, buffer_.size() - 1 - head_);
+      size_t count = symbols.spanForward(buffer_.data() + head_, span);
+      head_ += count;
+      moved += count;
+      if (count < span) {
+        break;
+      }
+    }
+    end_ = std::max(end_, head_ + 1);
+    return moved;
+  }
+
+  void appendWithHead(std::string& out) const {
+    out.append(buffer_.data() + begin_, head_ - begin_);
+    out += '[';
+    out += buffer_[head_];
+    out += ']';
+    out.append(buffer_.data() + head_ + 1, end_ - head_ - 1);
+  }
+
+private:
+  std::vector<char> buffer_;
+  size_t begin_;
+  size_t end_;
+  size_t head_;
+  size_t origin_;
+
+  void expandLeft() {
+    if (begin_ == 0) {
+      growLeft();
+    }
+    begin_--;
+  }
+
+  void growLeft() {
+    size_t added = buffer_.size();
+    buffer_.insert(buffer_.begin(), added, kBlank);
+    begin_ += added;
+    end_ += added;
+    head_ += added;
+    origin_ += added;
+  }
+
+  void expandRight() {
+    if (end_ == buffer_.size()) {
+      buffer_.resize(buffer_.size() * 2, kBlank);
+    }
+    end_++;
+  }
+};
+
+/**
+ * @brief Resultado de una ejecución
+ */
+struct RunResult {
+  uint32_t state;
+  size_t steps;
+  bool halted;
+};
+
+)";
+
+const char* kMain = R"(
+/**
+ * @brief Vuelca el buffer de salida
+ */
+void Flush(std::string& out) {
+  std::fwrite(out.data(), 1, out.size(), stdout);
+  out.clear();
+  std::fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t kBufferSize = 1 << 20;
+  size_t max_steps = 10000;
+  std::vector<std::string> positional;
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i) {
+    std::string arg = argv[i];
+    std::string value;
+    if (arg.rfind("--max-steps=", 0) == 0) {
+      value = arg.substr(12);
+    } else if (arg == "--max-steps" && i + 1 < argc) {
+      value = argv[++i];
+    } else if (arg.rfind("--", 0) == 0) {
+      valid = false;
+      break;
+    } else {
+      positional.push_back(arg);
+      continue;
+    }
+    valid = !value.empty() && value.find_first_not_of("0123456789") == std::string::npos;
+    if (valid) {
+      try {
+        max_steps = std::stoull(value);
+      } catch (const std::exception&) {
+        valid = false;
+      }
+      valid = valid && max_steps >= 1;
+    }
+  }
+  if (!valid || positional.size() != 1) {
+    std::cerr << "Uso: " << argv[0] << " [--max-steps N] <input_file>\n";
+    return 1;
+  }
+
+  std::ifstream file(positional[0], std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Error: No se pudo abrir el archivo de entrada: " << positional[0] << std::endl;
+    return 1;
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  const std::string data = content.str();
+
+  std::vector<Tape> tapes(kNumTapes);
+  std::string out;
+  out.reserve(kBufferSize + kBufferSize / 4);
+  size_t position = 0;
+  for (size_t index = 1; position < data.size(); ++index) {
+    size_t end = data.find('\n', position);
+    if (end == std::string::npos) {
+      end = data.size();
+    }
+    const char* input = data.data() + position;
+    size_t size = end - position;
+    position = end + 1;
+
+    out += "---------------------------------------------------\n";
+    out += "Cadena de entrada #";
+    out += std::to_string(index);
+    out += ": \"";
+    out.append(input, size);
+    out += "\"\n";
+    out += "---------------------------------------------------\n\n";
+
+    for (size_t i = 0; i < size; ++i) {
+      if (!kInputSymbols[static_cast<unsigned char>(input[i])]) {
+        Flush(out);
+        std::cerr << "Error: La cadena de entrada contiene símbolos que no pertenecen a Σ\n";
+        return 1;
+      }
+    }
+
+    for (size_t i = 0; i < kNumTapes; ++i) {
+      tapes[i].reset(input, i == 0 ? size : 0);
+    }
+    RunResult result = Run(tapes.data(), max_steps);
+
+    if (!result.halted) {
+      out += "La máquina excedió el número máximo de pasos\n\n";
+    }
+    out += "Resultado: ";
+    out += kFinal[result.state] ? "ACEPTADA" : "RECHAZADA";
+    out += "\nEstado final: ";
+    out += kStateNames[result.state];
+    out += "\nPasos ejecutados: ";
+    out += std::to_string(result.steps);
+    out += "\n\n";
+    for (size_t i = 0; i < kNumTapes; ++i) {
+      out += "Cinta ";
+      out += std::to_string(i + 1);
+      out += ": ";
+      tapes[i].appendWithHead(out);
+      out += "\n";
+    }
+    out += "\n";
+
+    if (out.size() >= kBufferSize) {
+      Flush(out);
+    }
+  }
+  Flush(out);
+  return 0;
+}
+)";
+
+/**
+ * @brief Escribe el programa completo
+ */
+void NativeGenerator::write(std::ostream& out) {
+  size_t num_states = program_.getNumStates();
+
+  // Solo se generan las transiciones que la tabla de despacho de la máquina elegiría para su
+  // clave (la primera definida), de modo que una clave repetida en la definición se resuelve igual
+  // que en MT
+  transitions_of_.assign(num_states, {});
+  std::set<std::pair<uint32_t, std::vector<char>>> keys;
+  for (size_t i = 0; i < program_.getNumTransitions(); ++i) {
+    Transition transition = program_.getTransition(i);
+    uint32_t state = program_.getStateIndex(transition.getCurrentState());
+    if (keys.emplace(state, transition.getReadSymbols()).second) {
+      transitions_of_[state].push_back(static_cast<int32_t>(i));
+    }
+  }
+
+  out << "// Generado por mt_compile a partir de " << source_ << ". No editar.\n";
+  out << "// Compilar con: make native DEF=<definition_file> (o g++ -std=c++17 -O2 -I<include del proyecto>)\n\n";
+  out << kPrologue;
+
+  out << "const size_t kNumTapes = " << program_.getNumTapes() << ";\n";
+  out << "const char kBlank = " << CharLiteral(program_.getBlankSymbol()) << ";\n\n";
+  out << "const char* const kStateNames[] = {";
+  for (uint32_t state = 0; state < num_states; ++state) {
+    out << (state % 8 == 0 ? "\n  " : " ") << StringLiteral(program_.getStateName(state)) << ",";
+  }
+  out << "\n};\n\n";
+  out << "const bool kFinal[] = {";
+  for (uint32_t state = 0; state < num_states; ++state) {
+    out << (state % 16 == 0 ? "\n  " : " ") << (program_.isFinal(state) ? "true" : "false") << ",";
+  }
+  out << "\n};\n\n";
+  out << "// Símbolos del alfabeto de entrada Σ\n";
+  out << "const bool kInputSymbols[256] = {";
+  for (int c = 0; c < 256; ++c) {
+    out << (c % 16 == 0 ? "\n  " : " ") << (input_alphabet_.contains(static_cast<char>(c)) ? 1 : 0) << ",";
+  }
+  out << "\n};\n";
+  out << kRuntime;
+
+  // Solo los estados alcanzables desde el inicial tienen bloque (y etiqueta)
+  std::vector<char> reachable(num_states, 0);
+  std::vector<uint32_t> pending = {program_.getInitialState()};
+  reachable[program_.getInitialState()] = 1;
+  while (!pending.empty()) {
+    uint32_t state = pending.back();
+    pending.pop_back();
+    for (int32_t transition : transitions_of_[state]) {
+      uint32_t next = program_.getNextState(transition);
+      if (!reachable[next]) {
+        reachable[next] = 1;
+        pending.push_back(next);
+      }
+    }
+  }
+  std::ostringstream body;
+  scan_sets_.clear();
+  for (uint32_t state = 0; state < num_states; ++state) {
+    if (reachable[state]) {
+      writeState(body, state);
+    }
+  }
+
+  if (!scan_sets_.empty()) {
+    out << "// Conjuntos de los bucles de barrido\n";
+    out << "SymbolSet MakeSymbolSet(const std::string& symbols) {\n";
+    out << "  SymbolSet set;\n";
+    out << "  for (char symbol : symbols) {\n";
+    out << "    set.insert(symbol);\n";
+    out << "  }\n";
+    out << "  return set;\n";
+    out << "}\n\n";
+    for (size_t i = 0; i < scan_sets_.size(); ++i) {
+      out << "const SymbolSet kScan" << i << " = MakeSymbolSet(" << StringLiteral(scan_sets_[i]) << ");\n";
+    }
+    out << "\n";
+  }
+  out << "/**\n";
+  out << " * @brief Ejecuta la máquina sobre las cintas ya inicializadas\n";
+  out << " *\n";
+  out << " * Cada estado es un bloque con etiqueta. Un paso sin transición aplicable detiene la máquina y\n";
+  out << " * cuenta como paso, igual que en MT.\n";
+  out << " */\n";
+  out << "RunResult Run(Tape* tapes, size_t max_steps) {\n";
+  out << "  size_t steps = 0;\n";
+  out << "  uint32_t state;\n";
+  out << "  goto s" << program_.getInitialState() << ";\n";
+  out << body.str();
+  out << "\nhalt:\n";
+  out << "  return {state, steps, true};\n";
+  out << "limit:\n";
+  out << "  return {state, steps, false};\n";
+  out << "}\n";
+
+  out << kMain;
+}
+
+/**
+ * @brief Escribe el bloque de un estado
+ */
+void NativeGenerator::writeState(std::ostream& out, uint32_t state) {
+  const std::vector<int32_t>& transitions = transitions_of_[state];
+
+  out << "\n// " << program_.getStateName(state) << "\n";
+  out << "s" << state << ":\n";
+  out << "  if (steps >= max_steps) {\n";
+  out << "    state = " << state << ";\n";
+  out << "    goto limit;\n";
+  out << "  }\n";
+  if (!transitions.empty()) {
+    writeSwitch(out, transitions, 0, "  ");
+  }
+  out << "  state = " << state << ";\n";
+  out << "  ++steps;\n";
+  out << "  goto halt;\n";
+}
+
+/**
+ * @brief Escribe el switch sobre el símbolo de una cinta para las transiciones dadas
+ *
+ * Las transiciones se agrupan por el símbolo leído en la cinta y cada grupo continúa con un
+ * switch sobre la cinta siguiente. Las que tienen comodín en la cinta entran en todos los grupos
+ * y forman además el caso default. En la última cinta cada caso aplica la transición que elegiría
+ * la tabla de despacho entre las que quedan.
+ */
+void NativeGenerator::writeSwitch(std::ostream& out, const std::vector<int32_t>& transitions, size_t tape,
+                                  const std::string& indent) {
+  std::map<char, std::vector<int32_t>> groups;
+  std::vector<int32_t> wildcards;
+  for (int32_t transition : transitions) {
+    char symbol = program_.getTransition(transition).getReadSymbols()[tape];
+    if (isWildcard(symbol)) {
+      wildcards.push_back(transition);
+    } else {
+      groups[symbol].push_back(transition);
+    }
+  }
+
+  bool last = tape + 1 == program_.getNumTapes();
+
+  // Sin símbolos concretos en esta cinta no hace falta leerla
+  if (groups.empty()) {
+    if (last) {
+      writeTransition(out, preferred(wildcards), indent);
+    } else {
+      writeSwitch(out, wildcards, tape + 1, indent);
+    }
+    return;
+  }
+
+  auto write_case = [&](const std::vector<int32_t>& group) {
+    if (last) {
+      writeTransition(out, preferred(group), indent + "    ");
+    } else {
+      writeSwitch(out, group, tape + 1, indent + "    ");
+      out << indent << "    break;\n";
+    }
+  };
+
+  out << indent << "switch (tapes[" << tape << "].read()) {\n";
+  for (auto& [symbol, group] : groups) {
+    group.insert(group.end(), wildcards.begin(), wildcards.end());
+    out << indent << "  case " << CharLiteral(symbol) << ":\n";
+    write_case(group);
+  }
+  if (!wildcards.empty()) {
+    out << indent << "  default:\n";
+    write_case(wildcards);
+  }
+  out << indent << "}\n";
+}
+
+/**
+ * @brief Indica si un símbolo leído o escrito es el comodín
+ */
+bool NativeGenerator::isWildcard(char symbol) const {
+  return program_.hasWildcards() && symbol == Transition::kWildcard;
+}
+
+/**
+ * @brief Transición que elige la tabla de despacho entre varias aplicables
+ * @return La de menos comodines y, a igualdad, la definida antes
+ */
+int32_t NativeGenerator::preferred(const std::vector<int32_t>& transitions) const {
+  int32_t best = transitions.front();
+  size_t best_wildcards = program_.getNumTapes() + 1;
+  for (int32_t transition : transitions) {
+    const std::vector<char> symbols = program_.getTransition(transition).getReadSymbols();
+    size_t wildcards = static_cast<size_t>(std::count_if(symbols.begin(), symbols.end(),
+                                                         [this](char symbol) { return isWildcard(symbol); }));
+    if (wildcards < best_wildcards || (wildcards == best_wildcards && transition < best)) {
+      best = transition;
+      best_wildcards = wildcards;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Escribe una transición: escrituras, movimientos y salto al estado siguiente
+ *
+ * Se omite la escritura cuando el símbolo escrito es el leído (o el comodín): en ese caso no cambia
+ * la celda ni la longitud de la cinta (los extremos de la cinta siempre son blancos). Los bucles de barrido
+ * detectados por CompiledMachine recorren toda la racha con un bucle sobre la cinta, igual que
+ * el ejecutor de MT.
+ */
+void NativeGenerator::writeTransition(std::ostream& out, int32_t transition, const std::string& indent) {
+  if (const CompiledMachine::ScanLoop* scan = program_.getScanLoop(transition)) {
+    std::string symbols;
+    for (int c = 0; c < 256; ++c) {
+      if (scan->symbols.contains(static_cast<char>(c))) {
+        symbols += static_cast<char>(c);
+      }
+    }
+    size_t set = std::find(scan_sets_.begin(), scan_sets_.end(), symbols) - scan_sets_.begin();
+    if (set == scan_sets_.size()) {
+      scan_sets_.push_back(symbols);
+    }
+    out << indent << "steps += tapes[" << scan->tape << "]."
+        << (scan->movement == Movement::LEFT ? "scanLeft" : "scanRight") << "(kScan" << set
+        << ", max_steps - steps);\n";
+    out << indent << "goto s" << program_.getNextState(transition) << ";\n";
+    return;
+  }
+
+  Transition definition = program_.getTransition(transition);
+  for (size_t i = 0; i < program_.getNumTapes(); ++i) {
+    char read = definition.getReadSymbols()[i];
+    char write = definition.getWriteSymbols()[i];
+    if (!isWildcard(write) && write != read) {
+      out << indent << "tapes[" << i << "].write(" << CharLiteral(write) << ");\n";
+    }
+    switch (definition.getMovements()[i]) {
+      case Movement::LEFT:
+        out << indent << "tapes[" << i << "].moveLeft();\n";
+        break;
+      case Movement::RIGHT:
+        out << indent << "tapes[" << i << "].moveRight();\n";
+        break;
+      case Movement::STAY:
+        break;
+    }
+  }
+  out << indent << "++steps;\n";
+  out << indent << "goto s" << program_.getNextState(transition) << ";\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string option = argc == 4 ? argv[1] : "";
+  if (argc != 3 && !(argc == 4 && (option == "--no-optimize" || option == "--merge-states"))) {
+    std::cerr << "Uso: " << argv[0] << " [--no-optimize | --merge-states] <definition_file> <output_file>\n";
+    return 1;
+  }
+  const std::string definition_file = argv[argc - 2];
+  const std::string output_file = argv[argc - 1];
+
+  try {
+    TuringMachine tm = FileParser::parseMachineDefinition(definition_file);
+    if (option != "--no-optimize") {
+      MachineOptimizer::optimize(tm, option == "--merge-states");
+    }
+    std::shared_ptr<const CompiledMachine> program = tm.getProgram();
+
+    std::ostringstream source;
+    NativeGenerator(*program, tm.getInputAlphabet(), definition_file).write(source);
+
+    std::ofstream out(output_file);
+    if (!out.is_open() || !(out << source.str())) {
+      throw std::runtime_error("No se pudo escribir el fichero: " + output_file);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
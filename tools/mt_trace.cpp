@@ -0,0 +1,114 @@
+#include <iostream>
+#include <vector>
+#include "../include/Tape.hpp"
+#include "../include/TraceLog.hpp"
+#include "../include/Transition.hpp"
+#include "../include/TuringMachine.hpp"
+
+/**
+ * @brief Decodificador de trazas binarias
+ *
+ * Lee un fichero escrito con `MT --trace` y reconstruye la traza legible de cada ejecución
+ * (configuración inicial, cada transición aplicada con las cintas resultantes y la configuración
+ * final), con el mismo formato que TuringMachine::printTrace().
+ *
+ * Uso: mt_trace <trace_file>
+ */
+
+namespace {
+
+const char* kLine = "────────────────────────────────────────────────────\n";
+
+/**
+ * @brief Imprime una configuración con el formato de TuringMachine::printTrace()
+ */
+void PrintTrace(size_t step, const std::string& state, const std::vector<Tape>& tapes, const Transition* transition) {
+  std::cout << kLine;
+  std::cout << "Paso: " << step << "\n";
+  std::cout << "Estado: " << state << "\n";
+  for (size_t i = 0; i < tapes.size(); ++i) {
+    std::cout << "Cinta " << (i + 1) << ": " << tapes[i].getContentWithHead() << "\n";
+  }
+  if (transition != nullptr) {
+    std::cout << "\nTransición aplicada: " << transition->toString() << "\n";
+  } else {
+    std::cout << "\nConfiguración inicial\n";
+  }
+  std::cout << kLine << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Uso: " << argv[0] << " <trace_file>\n";
+    return 1;
+  }
+
+  try {
+    TraceReader reader(argv[1]);
+    std::vector<Tape> tapes(reader.getNumTapes(), Tape(reader.getBlankSymbol()));
+    std::vector<char> read(reader.getNumTapes());
+    std::vector<char> written(reader.getNumTapes());
+    uint32_t state = 0;
+    size_t step = 0;
+    size_t run = 0;
+
+    TraceEvent event;
+    while (reader.next(event)) {
+      switch (event.kind) {
+        case TraceEvent::Kind::RUN_BEGIN:
+          for (size_t i = 0; i < tapes.size(); ++i) {
+            tapes[i].reset(i == 0 ? event.input : "");
+          }
+          state = event.state;
+          step = 0;
+          std::cout << "---------------------------------------------------\n";
+          std::cout << "Cadena de entrada #" << ++run << ": \"" << event.input << "\"\n";
+          std::cout << "---------------------------------------------------\n\n";
+          std::cout << "\n╔════════════════════════════════════════════════════╗\n";
+          std::cout << "║           TRAZA DE EJECUCIÓN - MT                  ║\n";
+          std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+          PrintTrace(step, reader.getStateName(state), tapes, nullptr);
+          break;
+
+        case TraceEvent::Kind::STEP: {
+          for (size_t i = 0; i < tapes.size(); ++i) {
+            read[i] = tapes[i].read();
+            written[i] = event.changed[i] ? event.writes[i] : read[i];
+            tapes[i].write(written[i]);
+            if (event.moves[i] == Movement::LEFT) {
+              tapes[i].moveLeft();
+            } else if (event.moves[i] == Movement::RIGHT) {
+              tapes[i].moveRight();
+            }
+          }
+          Transition transition(reader.getStateName(state), read, reader.getStateName(event.state), written,
+                                event.moves);
+          state = event.state;
+          PrintTrace(step++, reader.getStateName(state), tapes, &transition);
+          break;
+        }
+
+        case TraceEvent::Kind::RUN_END:
+          if (event.status == RunStatus::HALTED) {
+            std::cout << "\n╔════════════════════════════════════════════════════╗\n";
+            std::cout << "║           CONFIGURACIÓN FINAL                      ║\n";
+            std::cout << "╚════════════════════════════════════════════════════╝\n\n";
+            std::cout << "Estado final: " << reader.getStateName(event.state) << "\n";
+            std::cout << "Total de pasos: " << event.steps << "\n";
+            std::cout << "Resultado: " << (reader.isFinal(event.state) ? "ACEPTADA" : "RECHAZADA") << "\n\n";
+          } else if (event.status == RunStatus::STEP_LIMIT) {
+            std::cout << "La máquina excedió el número máximo de pasos (" << event.steps << ")\n\n";
+          } else {
+            std::cout << "La máquina no se detiene (" << event.steps << " pasos)\n\n";
+          }
+          break;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}